@@ -0,0 +1,96 @@
+#include <array>
+#include <chrono>
+#include <iostream>
+#include "shared_memory/array.hpp"
+
+// compares the duration of setting and getting the items of an array
+// storing a 48 bytes struct directly (trivially copyable struct, copied
+// with memcpy) and serialized (same struct, made not trivially copyable
+// by a user provided copy constructor), with and without tracking the
+// changes of the array
+
+#define NB_ITEMS 100
+#define NB_ITERATIONS 100000
+
+class Contact
+{
+public:
+    Contact()
+    {
+        position.fill(0);
+        force.fill(0);
+    }
+    std::array<double, 3> position;
+    std::array<double, 3> force;
+    template <class Archive>
+    void serialize(Archive& archive)
+    {
+        archive(position, force);
+    }
+};
+
+class SerializedContact : public Contact
+{
+public:
+    SerializedContact()
+    {
+    }
+    SerializedContact(const SerializedContact& other) : Contact(other)
+    {
+    }
+    SerializedContact& operator=(const SerializedContact& other) = default;
+};
+
+static double nanoseconds_since(std::chrono::steady_clock::time_point start)
+{
+    auto end = std::chrono::steady_clock::now();
+    return static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+            .count());
+}
+
+template <typename T>
+void execute(const std::string& label, bool track_changes)
+{
+    std::string segment = "array_access";
+    shared_memory::clear_array(segment);
+    shared_memory::array<T> a(segment,
+                              NB_ITEMS,
+                              true,
+                              shared_memory::ARRAY_MUTEX,
+                              false,
+                              track_changes);
+
+    T contact;
+    auto start = std::chrono::steady_clock::now();
+    for (int iteration = 0; iteration < NB_ITERATIONS; iteration++)
+    {
+        contact.position[0] = iteration;
+        a.set(iteration % NB_ITEMS, contact);
+    }
+    double set_duration = nanoseconds_since(start) / NB_ITERATIONS;
+
+    double sum = 0;
+    start = std::chrono::steady_clock::now();
+    for (int iteration = 0; iteration < NB_ITERATIONS; iteration++)
+    {
+        a.get(iteration % NB_ITEMS, contact);
+        sum += contact.position[0];
+    }
+    double get_duration = nanoseconds_since(start) / NB_ITERATIONS;
+
+    std::cout << label << (track_changes ? ", tracking changes" : "")
+              << ": set " << set_duration << " ns | get "
+              << get_duration << " ns | irrelevant data: " << sum << "\n";
+}
+
+int main()
+{
+    std::cout << "\n";
+    execute<Contact>("stored directly", false);
+    execute<Contact>("stored directly", true);
+    execute<SerializedContact>("serialized", false);
+    execute<SerializedContact>("serialized", true);
+    std::cout << "\n";
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <iostream>
+#include "shared_memory/array.hpp"
+
+// compares the throughput of processes updating each their own element
+// of an array, with neighbouring elements sharing cache lines (packed
+// slots) and with each element in its own cache line (padded slots)
+
+#define NB_PROCESSES 4
+#define NB_UPDATES 20000000
+
+static std::string SEGMENT = "array_false_sharing";
+
+static void update(int index)
+{
+    shared_memory::array<double> a(
+        SEGMENT, NB_PROCESSES, false, shared_memory::ARRAY_UNSYNCHRONIZED);
+    double value;
+    for (int iteration = 0; iteration < NB_UPDATES; iteration++)
+    {
+        a.get(index, value);
+        a.set(index, value + 1);
+    }
+}
+
+void execute(bool padded_slots)
+{
+    shared_memory::clear_array(SEGMENT);
+    shared_memory::array<double> a(SEGMENT,
+                                   NB_PROCESSES,
+                                   true,
+                                   shared_memory::ARRAY_UNSYNCHRONIZED,
+                                   padded_slots);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int process = 0; process < NB_PROCESSES; process++)
+    {
+        if (fork() == 0)
+        {
+            update(process);
+            _exit(0);
+        }
+    }
+    for (int process = 0; process < NB_PROCESSES; process++)
+    {
+        wait(nullptr);
+    }
+    auto end = std::chrono::steady_clock::now();
+    double duration =
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+            .count() /
+        1e6;
+
+    double total = 0;
+    for (int process = 0; process < NB_PROCESSES; process++)
+    {
+        double value;
+        a.get(process, value);
+        total += value;
+    }
+
+    std::cout << (padded_slots ? "padded slots: " : "packed slots: ")
+              << total / duration / 1e6 << " million updates per second ("
+              << NB_PROCESSES << " processes)\n";
+}
+
+int main()
+{
+    std::cout << "\n";
+    execute(false);
+    execute(true);
+    std::cout << "\n";
+    return 0;
+}
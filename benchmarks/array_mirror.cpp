@@ -0,0 +1,74 @@
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include "shared_memory/array.hpp"
+
+// compares the duration of mirroring a large array into a local copy
+// by copying all its elements (get_all) and by copying only the elements
+// written since the previous copy (get_changed_since)
+
+#define NB_ITEMS 100000
+#define NB_CHANGED 100
+#define NB_ITERATIONS 1000
+
+static double microseconds_since(std::chrono::steady_clock::time_point start)
+{
+    auto end = std::chrono::steady_clock::now();
+    return static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+            .count()) /
+           1e3;
+}
+
+int main()
+{
+    std::string segment = "array_mirror";
+    shared_memory::clear_array(segment);
+    shared_memory::array<double> a(
+        segment, NB_ITEMS, true, shared_memory::ARRAY_MUTEX, false, true);
+
+    std::vector<double> mirror(NB_ITEMS);
+    std::size_t index = 1;
+    auto write = [&a, &index]() {
+        for (int i = 0; i < NB_CHANGED; i++)
+        {
+            // linear congruential generator
+            index = (index * 6364136223846793005ULL + 1442695040888963407ULL);
+            a.set((index >> 20) % NB_ITEMS, static_cast<double>(i));
+        }
+    };
+
+    double all_duration = 0;
+    for (int iteration = 0; iteration < NB_ITERATIONS; iteration++)
+    {
+        write();
+        auto start = std::chrono::steady_clock::now();
+        a.get_all(mirror);
+        all_duration += microseconds_since(start);
+    }
+
+    double changed_duration = 0;
+    std::uint64_t epoch = a.get_changed_since(
+        0, [&mirror](uint index, const double& value) {
+            mirror[index] = value;
+        });
+    for (int iteration = 0; iteration < NB_ITERATIONS; iteration++)
+    {
+        write();
+        auto start = std::chrono::steady_clock::now();
+        epoch = a.get_changed_since(
+            epoch, [&mirror](uint index, const double& value) {
+                mirror[index] = value;
+            });
+        changed_duration += microseconds_since(start);
+    }
+
+    std::cout << "\n"
+              << NB_CHANGED << " elements out of " << NB_ITEMS
+              << " written per iteration\n"
+              << "get_all: " << all_duration / NB_ITERATIONS
+              << " us per iteration\n"
+              << "get_changed_since: " << changed_duration / NB_ITERATIONS
+              << " us per iteration\n\n";
+    return 0;
+}
@@ -0,0 +1,109 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <new>
+#include "shared_memory/demos/four_int_values.hpp"
+#include "shared_memory/serializer.hpp"
+#include "shared_memory/shared_memory.hpp"
+
+// counts the heap allocations performed when reading serialized
+// instances from the shared memory
+
+static std::atomic<long int> nb_allocations(0);
+
+void* operator new(std::size_t size)
+{
+    nb_allocations++;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+// std::string constants rather than literals, so that no temporary
+// string is created (and allocated) at each call
+static const std::string SEGMENT("deserialization_allocations");
+static const std::string OBJECT("fiv");
+
+template <typename Function>
+void measure(const std::string& name, Function function)
+{
+    int nb_iterations = 1000000;  // 1 million
+
+    // warm up, e.g. for reserving the capacity of buffers
+    function();
+
+    long int allocations_before = nb_allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int iteration = 0; iteration < nb_iterations; iteration++)
+    {
+        function();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    long int allocations = nb_allocations - allocations_before;
+
+    long int duration_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+            .count();
+    double duration_seconds = static_cast<double>(duration_us) / 1e6;
+    double frequency = static_cast<double>(nb_iterations) / duration_seconds;
+
+    std::cout << name << ": frequency: " << frequency
+              << " | allocations per iteration: "
+              << static_cast<double>(allocations) / nb_iterations << "\n";
+}
+
+void execute()
+{
+    shared_memory::clear_shared_memory(SEGMENT);
+
+    shared_memory::Four_int_values fiv(1, 2, 3, 4);
+    shared_memory::serialize(SEGMENT, OBJECT, fiv);
+
+    std::cout << "\n";
+
+    std::string data;
+    measure("get (std::string)",
+            [&data]() { shared_memory::get(SEGMENT, OBJECT, data); });
+
+    char buffer[256];
+    std::size_t size;
+    measure("get (char buffer)", [&buffer, &size]() {
+        shared_memory::get(SEGMENT, OBJECT, buffer, 256, size);
+    });
+
+    shared_memory::Serializer<shared_memory::Four_int_values> serializer;
+    shared_memory::Four_int_values read;
+    measure("get (char buffer) and deserialize",
+            [&buffer, &size, &serializer, &read]() {
+                shared_memory::get(SEGMENT, OBJECT, buffer, 256, size);
+                serializer.deserialize(buffer, size, read);
+            });
+
+    measure("shared_memory::deserialize",
+            [&read]() { shared_memory::deserialize(SEGMENT, OBJECT, read); });
+
+    std::cout << "\n";
+
+    shared_memory::clear_shared_memory(SEGMENT);
+}
+
+int main()
+{
+    execute();
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <new>
+#include "shared_memory/demos/four_int_values.hpp"
+#include "shared_memory/exchange_manager_consumer.hpp"
+#include "shared_memory/exchange_manager_producer.hpp"
+
+// counts the heap allocations performed per item passed from an
+// exchange manager producer to an exchange manager consumer (both
+// in this process)
+
+static std::atomic<long int> nb_allocations(0);
+
+void* operator new(std::size_t size)
+{
+    nb_allocations++;
+    void* p = std::malloc(size == 0 ? 1 : size);
+    if (p == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+#define SEGMENT_ID "exchange_manager_allocations"
+#define OBJECT_ID "exchange_manager_allocations_object"
+#define QUEUE_SIZE 2000 * 4
+#define NB_ITEMS 100000
+
+typedef shared_memory::Exchange_manager_producer<shared_memory::Four_int_values,
+                                                 QUEUE_SIZE>
+    Producer;
+typedef shared_memory::Exchange_manager_consumer<shared_memory::Four_int_values,
+                                                 QUEUE_SIZE>
+    Consumer;
+
+template <typename Function>
+void measure(const std::string& name, Function function)
+{
+    // warm up, e.g. for reserving the capacity of buffers
+    function();
+
+    long int allocations_before = nb_allocations;
+    auto start = std::chrono::steady_clock::now();
+
+    for (int item = 0; item < NB_ITEMS; item++)
+    {
+        function();
+    }
+
+    auto end = std::chrono::steady_clock::now();
+    long int allocations = nb_allocations - allocations_before;
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cout << name << ": items per second: "
+              << static_cast<int>(NB_ITEMS / seconds)
+              << " | allocations per item: "
+              << static_cast<double>(allocations) / NB_ITEMS << "\n";
+}
+
+int main()
+{
+    Producer::clean_mutex(SEGMENT_ID);
+    Producer::clean_memory(SEGMENT_ID);
+
+    Producer producer(SEGMENT_ID, OBJECT_ID, true);
+    Consumer consumer(SEGMENT_ID, OBJECT_ID, false);
+
+    if (!producer.ready_to_produce() || !consumer.ready_to_consume())
+    {
+        std::cout << "failed to start the exchange\n";
+        return 1;
+    }
+
+    shared_memory::Four_int_values item(1, 2, 3, 4);
+    shared_memory::Four_int_values read;
+    std::deque<int> consumed_ids;
+
+    std::cout << "\n";
+
+    shared_memory::Serializer<shared_memory::Four_int_values> serializer;
+    measure("serialize (std::string)",
+            [&serializer, &item]() { serializer.serialize(item); });
+
+    // the queue has room for the item: serialized in the queue
+    measure("set, consume", [&]() {
+        producer.set(item);
+        consumer.consume(read);
+        producer.get(consumed_ids);
+        consumed_ids.clear();
+    });
+
+    // the queue is full: the item is buffered by the producer,
+    // and the oldest buffered item moves to the queue
+    while (producer.set(item))
+    {
+    }
+    measure("set (queue full), consume", [&]() {
+        producer.set(item);
+        consumer.consume(read);
+        producer.get(consumed_ids);
+        consumed_ids.clear();
+    });
+
+    std::cout << "\n";
+    return 0;
+}
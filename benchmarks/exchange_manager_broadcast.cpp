@@ -0,0 +1,123 @@
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+#include "shared_memory/demos/four_int_values.hpp"
+#include "shared_memory/exchange_manager_broadcast_consumer.hpp"
+#include "shared_memory/exchange_manager_broadcast_producer.hpp"
+#include "shared_memory/exchange_manager_consumer.hpp"
+#include "shared_memory/exchange_manager_producer.hpp"
+
+// number of items per second passed to NB_CONSUMERS consumers (all in
+// this process), either by one exchange manager per consumer (the
+// producer sets each item once per consumer) or by a broadcast exchange
+// manager (the producer sets each item once)
+
+#define SEGMENT_ID "exchange_manager_broadcast"
+#define OBJECT_ID "exchange_manager_broadcast_object"
+#define QUEUE_SIZE 2000 * 4
+#define NB_ITEMS 100000
+#define NB_CONSUMERS 4
+#define BATCH_SIZE 100
+
+typedef shared_memory::Exchange_manager_producer<shared_memory::Four_int_values,
+                                                 QUEUE_SIZE>
+    Producer;
+typedef shared_memory::Exchange_manager_consumer<shared_memory::Four_int_values,
+                                                 QUEUE_SIZE>
+    Consumer;
+typedef shared_memory::Exchange_manager_broadcast_producer<
+    shared_memory::Four_int_values,
+    QUEUE_SIZE,
+    NB_CONSUMERS>
+    Broadcast_producer;
+typedef shared_memory::Exchange_manager_broadcast_consumer<
+    shared_memory::Four_int_values,
+    QUEUE_SIZE,
+    NB_CONSUMERS>
+    Broadcast_consumer;
+
+static std::string segment_id(int consumer)
+{
+    return std::string(SEGMENT_ID) + "_" + std::to_string(consumer);
+}
+
+static double duplicated()
+{
+    std::vector<std::unique_ptr<Producer>> producers;
+    std::vector<std::unique_ptr<Consumer>> consumers;
+    for (int c = 0; c < NB_CONSUMERS; c++)
+    {
+        Producer::clean_mutex(segment_id(c));
+        Producer::clean_memory(segment_id(c));
+        producers.emplace_back(new Producer(segment_id(c), OBJECT_ID, true));
+        consumers.emplace_back(new Consumer(segment_id(c), OBJECT_ID, false));
+    }
+
+    std::vector<shared_memory::Four_int_values> items(
+        BATCH_SIZE, shared_memory::Four_int_values(1, 2, 3, 4));
+    std::deque<int> consumed_ids;
+    auto start = std::chrono::steady_clock::now();
+    for (int produced = 0; produced < NB_ITEMS; produced += BATCH_SIZE)
+    {
+        for (int c = 0; c < NB_CONSUMERS; c++)
+        {
+            producers[c]->set_batch(items);
+            while (consumers[c]->consume_batch(items.data(), BATCH_SIZE) > 0)
+            {
+            }
+            producers[c]->get(consumed_ids);
+            consumed_ids.clear();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+static double broadcast()
+{
+    Broadcast_producer::clean_mutex(SEGMENT_ID);
+    Broadcast_producer::clean_memory(SEGMENT_ID);
+    Broadcast_producer producer(SEGMENT_ID, OBJECT_ID);
+    std::vector<std::unique_ptr<Broadcast_consumer>> consumers;
+    for (int c = 0; c < NB_CONSUMERS; c++)
+    {
+        consumers.emplace_back(new Broadcast_consumer(SEGMENT_ID, OBJECT_ID, c));
+    }
+
+    std::vector<shared_memory::Four_int_values> items(
+        BATCH_SIZE, shared_memory::Four_int_values(1, 2, 3, 4));
+    std::deque<int> consumed_ids;
+    auto start = std::chrono::steady_clock::now();
+    for (int produced = 0; produced < NB_ITEMS; produced += BATCH_SIZE)
+    {
+        producer.set_batch(items);
+        for (int c = 0; c < NB_CONSUMERS; c++)
+        {
+            while (consumers[c]->consume_batch(items.data(), BATCH_SIZE) > 0)
+            {
+            }
+            producer.get(c, consumed_ids);
+            consumed_ids.clear();
+        }
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main()
+{
+    double seconds = duplicated();
+    std::cout << "\none exchange manager per consumer: " << NB_ITEMS
+              << " items to " << NB_CONSUMERS << " consumers in " << seconds
+              << " s: " << static_cast<int>(NB_ITEMS / seconds)
+              << " items/s\n";
+    seconds = broadcast();
+    std::cout << "\nbroadcast exchange manager: " << NB_ITEMS << " items to "
+              << NB_CONSUMERS << " consumers in " << seconds
+              << " s: " << static_cast<int>(NB_ITEMS / seconds)
+              << " items/s\n\n";
+    return 0;
+}
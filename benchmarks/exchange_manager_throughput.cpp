@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "shared_memory/demos/four_int_values.hpp"
+#include "shared_memory/exchange_manager_consumer.hpp"
+#include "shared_memory/exchange_manager_producer.hpp"
+
+// number of items per second passed from an exchange manager producer
+// to an exchange manager consumer (both in this process), filling the
+// queue then emptying it, one item at a time (set / consume) or
+// by batches (set_batch / consume_batch)
+
+#define SEGMENT_ID "exchange_manager_throughput"
+#define OBJECT_ID "exchange_manager_throughput_object"
+#define QUEUE_SIZE 2000 * 4
+#define NB_ITEMS 200000
+#define BATCH_SIZE 100
+
+typedef shared_memory::Exchange_manager_producer<shared_memory::Four_int_values,
+                                                 QUEUE_SIZE>
+    Producer;
+typedef shared_memory::Exchange_manager_consumer<shared_memory::Four_int_values,
+                                                 QUEUE_SIZE>
+    Consumer;
+
+static double run(bool batch)
+{
+    Producer::clean_mutex(SEGMENT_ID);
+    Producer::clean_memory(SEGMENT_ID);
+
+    Producer producer(SEGMENT_ID, OBJECT_ID, true);
+    Consumer consumer(SEGMENT_ID, OBJECT_ID, false);
+
+    if (!producer.ready_to_produce() || !consumer.ready_to_consume())
+    {
+        std::cout << "failed to start the exchange\n";
+        return -1;
+    }
+
+    shared_memory::Four_int_values item(1, 2, 3, 4);
+    std::vector<shared_memory::Four_int_values> items(BATCH_SIZE, item);
+    std::deque<int> consumed_ids;
+    int nb_produced = 0;
+    int nb_consumed = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    while (nb_consumed < NB_ITEMS)
+    {
+        // filling the queue (the items not fully shared are
+        // buffered by the producer)
+        bool shared = true;
+        while (shared && nb_produced < NB_ITEMS)
+        {
+            if (batch)
+            {
+                int nb = std::min(BATCH_SIZE, NB_ITEMS - nb_produced);
+                for (int i = 0; i < nb; i++)
+                {
+                    items[i].set_id(nb_produced + i);
+                }
+                shared = producer.set_batch(items.data(), nb);
+                nb_produced += nb;
+            }
+            else
+            {
+                item.set_id(nb_produced);
+                shared = producer.set(item);
+                nb_produced++;
+            }
+        }
+        if (batch)
+        {
+            std::size_t nb_read;
+            while ((nb_read = consumer.consume_batch(items.data(),
+                                                     BATCH_SIZE)) > 0)
+            {
+                nb_consumed += nb_read;
+            }
+        }
+        else
+        {
+            while (consumer.consume(item))
+            {
+                nb_consumed++;
+            }
+        }
+        producer.get(consumed_ids);
+        consumed_ids.clear();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+int main()
+{
+    bool batches[2] = {false, true};
+    for (bool batch : batches)
+    {
+        double seconds = run(batch);
+        if (seconds < 0)
+        {
+            return 1;
+        }
+        std::cout << "\n"
+                  << (batch ? "batches of " + std::to_string(BATCH_SIZE)
+                            : std::string("single items"))
+                  << ": " << NB_ITEMS << " items exchanged in " << seconds
+                  << " s: " << static_cast<int>(NB_ITEMS / seconds)
+                  << " items/s\n";
+    }
+    std::cout << "\n";
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include <time.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include "shared_memory/demos/four_int_values.hpp"
+#include "shared_memory/exchange_manager_consumer.hpp"
+#include "shared_memory/exchange_manager_producer.hpp"
+
+// cpu time used by an exchange manager consumer waiting for items set
+// by a producer at a low frequency, when polling consume and when
+// waiting with wait_for_items (both in this process)
+
+#define SEGMENT_ID "exchange_manager_wait"
+#define OBJECT_ID "exchange_manager_wait_object"
+#define QUEUE_SIZE 2000 * 4
+#define NB_ITEMS 200
+#define PERIOD_US 5000
+
+typedef shared_memory::Exchange_manager_producer<shared_memory::Four_int_values,
+                                                 QUEUE_SIZE>
+    Producer;
+typedef shared_memory::Exchange_manager_consumer<shared_memory::Four_int_values,
+                                                 QUEUE_SIZE>
+    Consumer;
+
+static double thread_cpu_seconds()
+{
+    timespec t;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &t);
+    return t.tv_sec + t.tv_nsec / 1e9;
+}
+
+// returns the cpu time of the consumer, in seconds
+static double run(bool wait)
+{
+    Producer::clean_mutex(SEGMENT_ID);
+    Producer::clean_memory(SEGMENT_ID);
+
+    Producer producer(SEGMENT_ID, OBJECT_ID, true);
+    Consumer consumer(SEGMENT_ID, OBJECT_ID, false);
+
+    if (!producer.ready_to_produce() || !consumer.ready_to_consume())
+    {
+        std::cout << "failed to start the exchange\n";
+        return -1;
+    }
+
+    std::atomic<double> cpu_seconds(0);
+    std::thread consuming([&consumer, &cpu_seconds, wait]() {
+        double start = thread_cpu_seconds();
+        shared_memory::Four_int_values item;
+        int nb_consumed = 0;
+        while (nb_consumed < NB_ITEMS)
+        {
+            if (wait)
+            {
+                consumer.wait_for_items(1e9);
+            }
+            while (consumer.consume(item))
+            {
+                nb_consumed++;
+            }
+        }
+        cpu_seconds = thread_cpu_seconds() - start;
+    });
+
+    shared_memory::Four_int_values item(1, 2, 3, 4);
+    for (int i = 0; i < NB_ITEMS; i++)
+    {
+        usleep(PERIOD_US);
+        item.set_id(i);
+        producer.set(item);
+    }
+    consuming.join();
+    return cpu_seconds;
+}
+
+int main()
+{
+    bool waits[2] = {false, true};
+    for (bool wait : waits)
+    {
+        double seconds = run(wait);
+        if (seconds < 0)
+        {
+            return 1;
+        }
+        std::cout << "\n"
+                  << (wait ? "wait_for_items" : "polling") << ": consumer cpu "
+                  << seconds << " s for " << NB_ITEMS << " items (one every "
+                  << PERIOD_US << " us)\n";
+    }
+    std::cout << "\n";
+    return 0;
+}
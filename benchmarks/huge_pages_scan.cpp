@@ -0,0 +1,102 @@
+#include <chrono>
+#include <fstream>
+#include <numeric>
+#include <vector>
+#include "shared_memory/shared_memory.hpp"
+
+// compares the throughput of scanning a large object of a segment
+// backed by regular pages and of a segment backed by huge pages.
+// Huge pages require /dev/shm to be mounted with huge pages enabled:
+// sudo mount -o remount,huge=advise /dev/shm
+
+#define NB_ITEMS (16 * 1024 * 1024)  // 128MB of doubles
+#define NB_RANDOM_READS (16 * 1024 * 1024)
+
+static double seconds_since(std::chrono::steady_clock::time_point start)
+{
+    auto end = std::chrono::steady_clock::now();
+    long int duration_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start)
+            .count();
+    return static_cast<double>(duration_us) / 1e6;
+}
+
+static std::string shmem_huge_pages()
+{
+    std::ifstream meminfo("/proc/meminfo");
+    std::string line;
+    while (std::getline(meminfo, line))
+    {
+        if (line.find("ShmemHugePages") == 0)
+        {
+            return line;
+        }
+    }
+    return "ShmemHugePages: unknown";
+}
+
+void execute(bool huge_pages)
+{
+    std::string segment = "huge_pages_scan";
+    shared_memory::clear_shared_memory(segment);
+
+    shared_memory::set_segment_sizes(NB_ITEMS * sizeof(double) / 1025 + 1024);
+    bool advised =
+        shared_memory::get_segment(segment, false, true, huge_pages)
+            .get_huge_pages();
+
+    std::vector<double> values(NB_ITEMS);
+    std::iota(values.begin(), values.end(), 0.);
+    shared_memory::set(segment, "values", values);
+
+    std::vector<std::size_t> indexes(NB_RANDOM_READS);
+    std::size_t index = 1;
+    for (std::size_t& i : indexes)
+    {
+        // linear congruential generator
+        index = (index * 6364136223846793005ULL + 1442695040888963407ULL);
+        i = (index >> 20) % NB_ITEMS;
+    }
+
+    std::cout << "\nhuge pages: " << (huge_pages ? "on" : "off")
+              << " (advice " << (advised ? "accepted" : "not given") << ") | "
+              << shmem_huge_pages() << "\n";
+
+    {
+        shared_memory::ReadView<double> view =
+            shared_memory::get_read_view<double>(segment, "values", NB_ITEMS);
+
+        auto start = std::chrono::steady_clock::now();
+        double sum = 0;
+        for (int iteration = 0; iteration < 10; iteration++)
+        {
+            sum += std::accumulate(view.begin(), view.end(), 0.);
+        }
+        double duration = seconds_since(start);
+        std::cout << "sequential scan: "
+                  << 10. * NB_ITEMS * sizeof(double) / duration / 1e9
+                  << " GB/s | irrelevant data: " << sum << "\n";
+
+        start = std::chrono::steady_clock::now();
+        sum = 0;
+        for (std::size_t i : indexes)
+        {
+            sum += view[i];
+        }
+        duration = seconds_since(start);
+        std::cout << "random reads: " << duration * 1e9 / NB_RANDOM_READS
+                  << " ns per read | irrelevant data: " << sum << "\n";
+    }
+
+    shared_memory::delete_segment(segment);
+    shared_memory::clear_shared_memory(segment);
+    shared_memory::set_default_segment_sizes();
+}
+
+int main()
+{
+    execute(false);
+    execute(true);
+    std::cout << "\n";
+    return 0;
+}
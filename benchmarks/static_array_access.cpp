@@ -0,0 +1,74 @@
+#include <chrono>
+#include <iostream>
+#include "shared_memory/array.hpp"
+#include "shared_memory/static_array.hpp"
+
+// compares the duration of setting and getting the items of an array of
+// doubles and of a static_array of doubles (with checked and unchecked
+// accessors), all unsynchronized, as in a real time loop
+
+#define NB_ITEMS 64
+#define NB_ITERATIONS 10000000
+
+static double nanoseconds_since(std::chrono::steady_clock::time_point start)
+{
+    auto end = std::chrono::steady_clock::now();
+    return static_cast<double>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start)
+            .count());
+}
+
+template <typename Set, typename Get>
+void execute(const std::string& label, Set set, Get get)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint iteration = 0; iteration < NB_ITERATIONS; iteration++)
+    {
+        set(iteration % NB_ITEMS, static_cast<double>(iteration));
+    }
+    double set_duration = nanoseconds_since(start) / NB_ITERATIONS;
+
+    double sum = 0;
+    double value;
+    start = std::chrono::steady_clock::now();
+    for (uint iteration = 0; iteration < NB_ITERATIONS; iteration++)
+    {
+        get(iteration % NB_ITEMS, value);
+        sum += value;
+    }
+    double get_duration = nanoseconds_since(start) / NB_ITERATIONS;
+
+    std::cout << label << ": set " << set_duration << " ns | get "
+              << get_duration << " ns | irrelevant data: " << sum << "\n";
+}
+
+int main()
+{
+    std::string segment = "static_array_access";
+    std::string static_segment = "static_array_access_static";
+    shared_memory::clear_array(segment);
+    shared_memory::clear_array(static_segment);
+
+    shared_memory::array<double> a(
+        segment, NB_ITEMS, true, shared_memory::ARRAY_UNSYNCHRONIZED);
+    shared_memory::static_array<double,
+                                NB_ITEMS,
+                                shared_memory::ARRAY_UNSYNCHRONIZED>
+        s(static_segment);
+
+    std::cout << "\n";
+    execute(
+        "array",
+        [&a](uint index, double value) { a.set(index, value); },
+        [&a](uint index, double& value) { a.get(index, value); });
+    execute(
+        "static_array",
+        [&s](uint index, double value) { s.set(index, value); },
+        [&s](uint index, double& value) { s.get(index, value); });
+    execute(
+        "static_array (unchecked)",
+        [&s](uint index, double value) { s.set_unchecked(index, value); },
+        [&s](uint index, double& value) { s.get_unchecked(index, value); });
+    std::cout << "\n";
+    return 0;
+}
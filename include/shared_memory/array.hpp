@@ -10,14 +10,24 @@
 #include "shared_memory/shared_memory.hpp"
 
 // This header
-// - defines types SERIALIZABLE, FUNDAMENTAL and FUNDAMENTAL_ARRAY
+// - defines types SERIALIZABLE, FUNDAMENTAL, FUNDAMENTAL_ARRAY and
+// TRIVIALLY_COPYABLE
 // - defines super class array_member, which declares the private
 // members specific for each implementation (serializable,
-// fundamental and fundamental array)
+// fundamental, fundamental array and trivially copyable)
 #include "shared_memory/internal/array_members.hpp"
+#include "shared_memory/internal/array_layout.hpp"
+#include "shared_memory/internal/array_mapping.hpp"
+#include "shared_memory/internal/array_notification.hpp"
+#include "shared_memory/internal/segment_sizer.hpp"
 
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
+#include <memory>
 #include <stdexcept>
+#include <vector>
 
 namespace shared_memory
 {
@@ -31,12 +41,45 @@ namespace shared_memory
  */
 void clear_array(std::string segment_id);
 
+/**
+ * @brief synchronization of the accesses to the elements of a
+ * shared_memory::array. All the instances of shared_memory::array
+ * pointing to the same segment should use the same value.
+ */
+enum ArraySync
+{
+    /**
+     * @brief no synchronization: accesses should be protected
+     * via a shared_memory::Mutex
+     */
+    ARRAY_UNSYNCHRONIZED,
+    /**
+     * @brief all accesses lock the interprocess mutex of the array
+     */
+    ARRAY_MUTEX,
+    /**
+     * @brief single writer, multiple readers: each element carries a
+     * sequence counter incremented before and after each write, and
+     * readers repeat their copy (without locking) until no write
+     * occurred meanwhile. Only one instance (in one thread of one
+     * process) may call the set functions.
+     */
+    ARRAY_SINGLE_WRITER
+};
+
+template <typename T, int SIZE>
+class ring_buffer;
+
 /**
  * Implement a shared array stored on a shared memory
  * segment. Items hosted by the array may be of (1) fundamental
  * type (e.g. int, double, char), (2) array of fundamental type
- * (e.g. int[10]); or (3) instances of a class implementing a
- * serializable function (see shared_memory::serializer).
+ * (e.g. int[10]); (3) instances of a class implementing a
+ * serializable function (see shared_memory::serializer); or (4)
+ * instances of a trivially copyable class, which are stored directly
+ * (i.e. not serialized) and copied with memcpy. Trivially copyable classes
+ * implementing a serializable function are stored directly as well (which
+ * is not compatible with the serialized format used by earlier versions).
  */
 template <typename T, int SIZE = 0>
 class array : public internal::array_members<T, SIZE>
@@ -46,9 +89,51 @@ private:
     // implementation for fundamental types
     // ------------------------------------
 
+    char* init_segment(std::size_t item_size);
+    // size of the segment, for items of item_size bytes
+    std::size_t get_segment_size(std::size_t item_size) const;
+    void init_sequences();
+    void init_notification();
+    std::size_t get_nb_blocks() const;
+    // bytes between the stamps (of stamps_size bytes) of two consecutive
+    // elements or blocks: a cache line if the slots are padded
+    std::size_t get_stamps_stride(std::size_t stamps_size) const;
+    internal::ElementStamps& element_stamps(uint index) const;
+    internal::Generation& block_stamp(std::size_t block) const;
+    // throws a std::logic_error if the array does not track changes
+    void check_track_changes() const;
+    // counts the write of the elements begin to begin + span - 1 in
+    // their generations and update stamps, and in the generation of the
+    // array (if the array tracks changes). Called by the writer before
+    // releasing the mutex of the array (if any): writes are serialized,
+    // so no lock is taken here
+    void publish_update(uint begin, std::size_t span);
+    // wakes up the instances waiting for updates (if any), after the
+    // writer released the mutex of the array
+    void notify_update();
+    std::size_t get_slot_size(std::size_t item_size) const;
+    char* init_slots(std::size_t item_size);
+    // address of the element at index
+    char* slot(uint index) const;
+    // copy span items of item_size bytes to / from the slots of the
+    // elements begin to begin + span - 1
+    void write_slots(uint begin,
+                     const void* items,
+                     std::size_t span,
+                     std::size_t item_size);
+    void read_slots(uint begin,
+                    void* items,
+                    std::size_t span,
+                    std::size_t item_size) const;
+
     void init(FUNDAMENTAL);
     void set(uint index, const T& t, FUNDAMENTAL);
     void get(uint index, T& t, FUNDAMENTAL);
+    // get, without locking the mutex of the array (copies of single
+    // writer arrays are still validated by the sequence of the element)
+    void copy_item(uint index, T& t, FUNDAMENTAL);
+    void set_range(uint begin, const T* t, std::size_t span, FUNDAMENTAL);
+    void get_range(uint begin, T* t, std::size_t span, FUNDAMENTAL);
     std::string get_serialized(uint index,
                                FUNDAMENTAL);  // throws std::logic_error
 
@@ -59,6 +144,12 @@ private:
     void init(FUNDAMENTAL_ARRAY);
     void set(uint index, const T& t, FUNDAMENTAL_ARRAY);
     void get(uint index, T& t, FUNDAMENTAL_ARRAY);
+    void copy_item(uint index, T& t, FUNDAMENTAL_ARRAY);
+    void set_range(uint begin,
+                   const T* t,
+                   std::size_t span,
+                   FUNDAMENTAL_ARRAY);
+    void get_range(uint begin, T* t, std::size_t span, FUNDAMENTAL_ARRAY);
     std::string get_serialized(uint index,
                                FUNDAMENTAL_ARRAY);  // throws std::logic_error
 
@@ -69,8 +160,27 @@ private:
     void init(SERIALIZABLE);
     void set(uint index, const T& t, SERIALIZABLE);
     void get(uint index, T& t, SERIALIZABLE);
+    void copy_item(uint index, T& t, SERIALIZABLE);
+    void set_range(uint begin, const T* t, std::size_t span, SERIALIZABLE);
+    void get_range(uint begin, T* t, std::size_t span, SERIALIZABLE);
     std::string get_serialized(uint index, SERIALIZABLE);
 
+    // ------------------------------------------------
+    // implementation for instances of trivially copyable
+    // classes
+    // ------------------------------------------------
+
+    void init(TRIVIALLY_COPYABLE);
+    void set(uint index, const T& t, TRIVIALLY_COPYABLE);
+    void get(uint index, T& t, TRIVIALLY_COPYABLE);
+    void copy_item(uint index, T& t, TRIVIALLY_COPYABLE);
+    void set_range(uint begin,
+                   const T* t,
+                   std::size_t span,
+                   TRIVIALLY_COPYABLE);
+    void get_range(uint begin, T* t, std::size_t span, TRIVIALLY_COPYABLE);
+    std::string get_serialized(uint index, TRIVIALLY_COPYABLE);
+
 public:
     /**
      * @param segment_id should be the same for
@@ -91,23 +201,58 @@ public:
           bool clear_on_destruction = true,
           bool multiprocess_safe = true);
 
+    /**
+     * @param segment_id should be the same for
+     * all array pointing to the same shared memory segment
+     * @param size : number of elements to be stored by the array
+     * @param clear_on_destruction: see constructor above
+     * @param sync synchronization of the accesses to the elements
+     * (see shared_memory::ArraySync)
+     * @param padded_slots if true, each element is stored in its own
+     * cache line(s), so that processes updating neighbouring elements
+     * do not invalidate each other's cache lines (false sharing). Only the
+     * value passed by the instance creating the segment matters: other
+     * instances use the layout stored in the segment.
+     * @param track_changes if true, writes are counted in generations
+     * and update stamps stored in the segment, which get_generation,
+     * wait_for_update, wait_for_any_update and get_changed_since rely on
+     * (they throw a std::logic_error otherwise). Tracking costs each
+     * write a few atomic updates, and possibly waking up waiters. As for
+     * padded_slots, only the value passed by the instance creating the
+     * segment matters.
+     * @param huge_pages if true, the mapping of the segment is backed by
+     * huge pages when available (see shared_memory::SharedMemorySegment)
+     */
+    array(std::string segment_id,
+          std::size_t size,
+          bool clear_on_destruction,
+          ArraySync sync,
+          bool padded_slots = false,
+          bool track_changes = false,
+          bool huge_pages = false);
+
     /**
      * wipe the related shared memory segment
-     * if clear_on_destruction is true (true by default)
+     * if clear_on_destruction is true (true by default) and if
+     * this is the last copy of this array
      */
     ~array();
 
     /**
      * this array and other array will point to the
      * same memory segment, and will have same values for
-     * clear_on_destruction and multiprocess_safe
+     * clear_on_destruction, sync, padded_slots and track_changes.
+     * The mapping of the segment is shared with other rather than
+     * opened again, so copying is cheap (e.g. for passing arrays
+     * to threads by value). The segment is wiped (if clear_on_destruction
+     * is true) only when the last copy is destroyed.
      */
     array(const array<T, SIZE>& other);
 
     /**
      * This array will point to the share memory segment
-     * pointed at by other; and will have same value for
-     * multprocess_safe and clear_on_destruction.
+     * pointed at by other (taking over its mapping); and will have
+     * same value for sync and clear_on_destruction.
      * Warning: even if other.clear_on_destruction is
      * true, the segment memory will not be wiped on the destruction
      * of other. The duty of deleting the shared memory is passed
@@ -117,8 +262,10 @@ public:
 
     /**
      * This array will point to the share memory segment
-     * pointed at by other; and will have same value for
-     * multprocess_safe and clear_on_destruction.
+     * pointed at by other (taking over its mapping); and will have
+     * same value for sync and clear_on_destruction.
+     * The segment this array pointed at before is released as if this
+     * array was destroyed.
      * Warning: even if other.clear_on_destruction is
      * true, the segment memory will not be wiped on the destruction
      * of other. The duty of deleting the shared memory is passed
@@ -146,11 +293,96 @@ public:
      */
     void get(uint index, T* t);
 
+    /**
+     * @brief set the span elements of t at indexes begin to
+     * begin + span - 1, locking the array only once (ARRAY_SINGLE_WRITER:
+     * readers see either none or all of the new elements). For arrays of arrays of
+     * fundamental types (SIZE > 0), t points to span * SIZE values.
+     */
+    void set_range(uint begin, const T* t, std::size_t span);
+
+    /**
+     * @brief read the span elements at indexes begin to begin + span - 1
+     * into t, locking the array only once (ARRAY_SINGLE_WRITER: the
+     * elements are read as a consistent snapshot). For arrays of arrays of
+     * fundamental types (SIZE > 0), t points to span * SIZE values.
+     */
+    void get_range(uint begin, T* t, std::size_t span);
+
+    /**
+     * @brief set all the elements of the array, locking it only once.
+     * values should be of size size() (or size() * SIZE for arrays of
+     * arrays of fundamental types).
+     */
+    void set_all(const std::vector<T>& values);
+
+    /**
+     * @brief read a snapshot of all the elements of the array into values,
+     * locking the array only once. values is resized to size() (or
+     * size() * SIZE for arrays of arrays of fundamental types).
+     */
+    void get_all(std::vector<T>& values);
+
+    /**
+     * @brief number of times the element at index has been written
+     * since the creation of the array (by any instance pointing to the
+     * same segment). Arrays tracking changes only (see constructor).
+     */
+    std::uint64_t get_generation(uint index) const;
+
+    /**
+     * @brief number of times elements of the array have been written
+     * since the creation of the array (a set_range or set_all counts as
+     * one write). Arrays tracking changes only.
+     */
+    std::uint64_t get_generation() const;
+
+    /**
+     * @brief wait until the element at index is written, i.e. until its
+     * generation differs from last_seen (see get_generation). Arrays
+     * tracking changes only.
+     * @param timeout_nano_seconds negative for no timeout
+     * @return false if the timeout expired before the element was written
+     */
+    bool wait_for_update(uint index,
+                         std::uint64_t last_seen,
+                         long timeout_nano_seconds = -1);
+
+    /**
+     * @brief wait until any element of the array is written, i.e. until
+     * the generation of the array differs from last_seen
+     * (see get_generation). Arrays tracking changes only.
+     * @param timeout_nano_seconds negative for no timeout
+     * @return false if the timeout expired before an element was written
+     */
+    bool wait_for_any_update(std::uint64_t last_seen,
+                             long timeout_nano_seconds = -1);
+
+    /**
+     * @brief calls callback(index, element) for each element written
+     * after the write counted by the array generation epoch (see
+     * get_generation), and returns the generation to pass as epoch to the
+     * next call. Elements written during the call may be reported again
+     * by the next call. Only the update stamps of blocks of 64 elements
+     * are read for blocks without any element written, so that readers
+     * mirroring an array copy only the written elements. For arrays of
+     * arrays of fundamental types (SIZE > 0), element points to SIZE
+     * values. Arrays tracking changes only.
+     */
+    template <typename Callback>
+    std::uint64_t get_changed_since(std::uint64_t epoch, Callback callback);
+
     /**
      * @brief max number of elements in the array
      */
     std::size_t size() const;
 
+    /**
+     * @brief true if the array has been constructed with huge_pages and
+     * the kernel accepted to back the mapping of its segment with huge pages
+     */
+    bool get_huge_pages() const;
+
     /**
      * @brief return the serialized string representation of
      * the element if T is a serializable class. Throws a logic error otherwise.
@@ -167,14 +399,45 @@ public:
     void* get_raw();
 
 private:
-    boost::interprocess::managed_shared_memory segment_manager_;
+    // stores its indexes in the segment of its array
+    friend class ring_buffer<T, SIZE>;
+
+    // extra_objects: objects constructed in the segment (after the
+    // objects of the array) by the friends of the array
+    array(std::string segment_id,
+          std::size_t size,
+          bool clear_on_destruction,
+          ArraySync sync,
+          bool padded_slots,
+          bool track_changes,
+          bool huge_pages,
+          const internal::SegmentSizer& extra_objects);
+
+private:
+    // segment and mutex, shared by the copies of this array
+    std::shared_ptr<internal::ArrayMapping> mapping_;
     std::string segment_id_;
     std::size_t size_;           // number of elements in array
-    bool clear_on_destruction_;  // memory segment will be clear at destruction
-                                 // if true
+    ArraySync sync_;
     bool multiprocess_safe_;     // protects all operation with an interprocess
                                  // mutex if true
-    shared_memory::Mutex mutex_;
+    bool padded_slots_;          // layout requested at construction, then
+    bool track_changes_;         // as stored in the segment
+    bool huge_pages_;            // requested at construction
+    std::size_t slot_size_;      // layout stored in the segment: bytes between
+                                 // two consecutive elements
+    // generation and update stamp of each element, and array generation
+    // at the last write of each block of internal::ARRAY_BLOCK_SIZE
+    // elements (nullptr unless the array tracks changes)
+    char* element_stamps_;
+    char* block_stamps_;
+    // elements read by get_changed_since
+    std::vector<uint> changed_indexes_;
+    std::vector<T> changed_items_;
+    // nullptr unless the array tracks changes
+    internal::ArrayNotification* notification_;
+    // objects constructed in the segment by friends of the array
+    internal::SegmentSizer extra_objects_;
 };
 
 // code common for all implementations
@@ -194,4 +457,8 @@ private:
 // the serialize function (see shared_memory/serializer.hpp)
 #include "array_serializable.hxx"
 
+// implementation for trivially copyable classes
+// (e.g. plain structs)
+#include "array_trivially_copyable.hxx"
+
 }  // namespace shared_memory
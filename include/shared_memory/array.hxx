@@ -1,90 +1,442 @@
 // Copyright (c) 2019 Max Planck Gesellschaft
 // Author : Vincent Berenz
 
-// to make sure size of segments are multiple
-// of 1025
-static uint get_segment_size(size_t size_array, size_t size_item)
+template <typename T, int SIZE>
+array<T, SIZE>::array(std::string segment_id,
+                      std::size_t size,
+                      bool clear_on_destruction,
+                      bool multiprocess_safe)
+    : array(segment_id,
+            size,
+            clear_on_destruction,
+            multiprocess_safe ? ARRAY_MUTEX : ARRAY_UNSYNCHRONIZED)
 {
-    size_t total_desired_size = size_array * size_item;
-    double multiplier_d = static_cast<double>(total_desired_size) / 1025.0;
-    // + 1 because int rounds to lower bound
-    // + 2 for memory padding
-    uint multiplier = static_cast<uint>(multiplier_d) + 2;
-    uint value = multiplier * 1025 * 2;
-    return value;
 }
 
 template <typename T, int SIZE>
 array<T, SIZE>::array(std::string segment_id,
                       std::size_t size,
                       bool clear_on_destruction,
-                      bool multiprocess_safe)
-    : segment_id_(segment_id),
+                      ArraySync sync,
+                      bool padded_slots,
+                      bool track_changes,
+                      bool huge_pages)
+    : array(segment_id,
+            size,
+            clear_on_destruction,
+            sync,
+            padded_slots,
+            track_changes,
+            huge_pages,
+            internal::SegmentSizer())
+{
+}
+
+template <typename T, int SIZE>
+array<T, SIZE>::array(std::string segment_id,
+                      std::size_t size,
+                      bool clear_on_destruction,
+                      ArraySync sync,
+                      bool padded_slots,
+                      bool track_changes,
+                      bool huge_pages,
+                      const internal::SegmentSizer& extra_objects)
+    : mapping_(std::make_shared<internal::ArrayMapping>(segment_id,
+                                                        clear_on_destruction)),
+      segment_id_(segment_id),
       size_(size),
-      clear_on_destruction_(clear_on_destruction),
-      multiprocess_safe_(multiprocess_safe),
-      mutex_(segment_id + std::string("_mutex"), clear_on_destruction)
+      sync_(sync),
+      multiprocess_safe_(sync == ARRAY_MUTEX),
+      padded_slots_(padded_slots),
+      track_changes_(track_changes),
+      huge_pages_(huge_pages),
+      extra_objects_(extra_objects)
 {
     init(this->type_);
 }
 
+// copies share the mapping of the segment (and the mutex), and the
+// addresses of the items in it: no call to init
+
 template <typename T, int SIZE>
-array<T, SIZE>::array(const array<T, SIZE>& other)
-    : segment_id_(other.segment_id_),
-      size_(other.size_),
-      clear_on_destruction_(other.clear_on_destruction_),
-      multiprocess_safe_(other.multiprocess_safe_),
-      mutex_(segment_id_ + std::string("_mutex"), clear_on_destruction_)
+array<T, SIZE>::array(const array<T, SIZE>& other) = default;
+
+template <typename T, int SIZE>
+array<T, SIZE>::array(array<T, SIZE>&& other) noexcept = default;
+
+template <typename T, int SIZE>
+array<T, SIZE>& array<T, SIZE>::operator=(array<T, SIZE>&& other) noexcept =
+    default;
+
+template <typename T, int SIZE>
+char* array<T, SIZE>::init_segment(std::size_t item_size)
 {
-    init(this->type_);
+    mapping_->segment = boost::interprocess::managed_shared_memory(
+        boost::interprocess::open_or_create,
+        segment_id_.c_str(),
+        get_segment_size(item_size));
+    if (huge_pages_)
+    {
+        mapping_->huge_pages = internal::advise_huge_pages(mapping_->segment);
+    }
+    char* slots = init_slots(item_size);
+    init_sequences();
+    init_notification();
+    return slots;
 }
 
 template <typename T, int SIZE>
-array<T, SIZE>::array(array<T, SIZE>&& other) noexcept
-    : segment_id_(other.segment_id_),
-      size_(other.size_),
-      clear_on_destruction_(other.clear_on_destruction_),
-      multiprocess_safe_(other.multiprocess_safe_),
-      mutex_(segment_id_ + std::string("_mutex"), clear_on_destruction_)
+std::size_t array<T, SIZE>::get_segment_size(std::size_t item_size) const
 {
-    init(this->type_);
-    other.shared_ = nullptr;
-    other.clear_on_destruction_ = false;
+    // objects constructed by init_slots, init_sequences and
+    // init_notification (in this order)
+    internal::SegmentSizer sizer;
+    sizer.add<internal::ArrayLayout>(segment_id_ + std::string("_layout"));
+    sizer.add<char>(segment_id_,
+                    size_ * get_slot_size(item_size) +
+                        internal::CACHE_LINE_SIZE);
+    if (sync_ == ARRAY_SINGLE_WRITER)
+    {
+        sizer.add<internal::Sequence>(segment_id_ + std::string("_sequences"),
+                                      size_);
+    }
+    if (track_changes_)
+    {
+        sizer.add<char>(
+            segment_id_ + std::string("_element_stamps"),
+            size_ * get_stamps_stride(sizeof(internal::ElementStamps)) +
+                internal::CACHE_LINE_SIZE);
+        sizer.add<char>(
+            segment_id_ + std::string("_block_stamps"),
+            get_nb_blocks() * get_stamps_stride(sizeof(internal::Generation)) +
+                internal::CACHE_LINE_SIZE);
+        sizer.add<internal::ArrayNotification>(segment_id_ +
+                                               std::string("_notification"));
+    }
+    sizer.add(extra_objects_);
+    return sizer.get_segment_size();
 }
 
 template <typename T, int SIZE>
-array<T, SIZE>& array<T, SIZE>::operator=(array<T, SIZE>&& other) noexcept
+void array<T, SIZE>::init_sequences()
 {
-    segment_id_ = other.segment_id_;
-    size_ = other.size_;
-    clear_on_destruction_ = other.clear_on_destruction_;
-    other.clear_on_destruction_ = false;
-    multiprocess_safe_ = other.multiprocess_safe_;
-    init(this->type);
-    mutex_ = other.mutex_;
-    other.shared_ = nullptr;
-    return *this;
+    if (sync_ != ARRAY_SINGLE_WRITER)
+    {
+        this->sequences_ = nullptr;
+        return;
+    }
+    this->sequences_ =
+        mapping_->segment.find_or_construct<internal::Sequence>(
+            (segment_id_ + std::string("_sequences")).c_str())[size_](0);
 }
 
 template <typename T, int SIZE>
-array<T, SIZE>::~array()
+std::size_t array<T, SIZE>::get_nb_blocks() const
+{
+    return (size_ + internal::ARRAY_BLOCK_SIZE - 1) /
+           internal::ARRAY_BLOCK_SIZE;
+}
+
+template <typename T, int SIZE>
+std::size_t array<T, SIZE>::get_stamps_stride(std::size_t stamps_size) const
+{
+    return padded_slots_ ? internal::CACHE_LINE_SIZE : stamps_size;
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::init_notification()
+{
+    element_stamps_ = nullptr;
+    block_stamps_ = nullptr;
+    notification_ = nullptr;
+    if (!track_changes_)
+    {
+        return;
+    }
+    // zeroed memory, with one more cache line for aligning the first
+    // stamps (see init_slots)
+    element_stamps_ = internal::align_to_cache_line(
+        mapping_->segment.find_or_construct<char>(
+            (segment_id_ + std::string("_element_stamps")).c_str())
+            [size_ * get_stamps_stride(sizeof(internal::ElementStamps)) +
+             internal::CACHE_LINE_SIZE](0));
+    block_stamps_ = internal::align_to_cache_line(
+        mapping_->segment.find_or_construct<char>(
+            (segment_id_ + std::string("_block_stamps")).c_str())
+            [get_nb_blocks() * get_stamps_stride(sizeof(internal::Generation)) +
+             internal::CACHE_LINE_SIZE](0));
+    notification_ =
+        mapping_->segment.find_or_construct<internal::ArrayNotification>(
+            (segment_id_ + std::string("_notification")).c_str())();
+}
+
+template <typename T, int SIZE>
+internal::ElementStamps& array<T, SIZE>::element_stamps(uint index) const
+{
+    return *reinterpret_cast<internal::ElementStamps*>(
+        element_stamps_ +
+        index * get_stamps_stride(sizeof(internal::ElementStamps)));
+}
+
+template <typename T, int SIZE>
+internal::Generation& array<T, SIZE>::block_stamp(std::size_t block) const
+{
+    return *reinterpret_cast<internal::Generation*>(
+        block_stamps_ + block * get_stamps_stride(sizeof(internal::Generation)));
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::check_track_changes() const
+{
+    if (!track_changes_)
+    {
+        throw std::logic_error("array " + segment_id_ +
+                               " does not track changes (see the "
+                               "constructor argument track_changes)");
+    }
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::publish_update(uint begin, std::size_t span)
 {
-    if (clear_on_destruction_)
+    if (!track_changes_)
     {
-        clear_array(segment_id_);
+        return;
     }
+    std::uint64_t generation =
+        notification_->generation.load(std::memory_order_relaxed) + 1;
+    for (std::size_t i = begin; i < begin + span; i++)
+    {
+        internal::ElementStamps& stamps = element_stamps(i);
+        stamps.generation.fetch_add(1);
+        internal::store_max(stamps.updated_at, generation);
+    }
+    for (std::size_t block = begin / internal::ARRAY_BLOCK_SIZE;
+         block <= (begin + span - 1) / internal::ARRAY_BLOCK_SIZE;
+         block++)
+    {
+        internal::store_max(block_stamp(block), generation);
+    }
+    // readers loading the generation of the array see the stamps
+    notification_->generation.fetch_add(1);
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::notify_update()
+{
+    // only arrays tracking changes have waiters
+    if (track_changes_)
+    {
+        internal::notify_waiters(*notification_);
+    }
+}
+
+template <typename T, int SIZE>
+std::uint64_t array<T, SIZE>::get_generation(uint index) const
+{
+    check_track_changes();
+    if (index >= size_)
+    {
+        throw std::runtime_error("invalid index");
+    }
+    return element_stamps(index).generation.load();
+}
+
+template <typename T, int SIZE>
+std::uint64_t array<T, SIZE>::get_generation() const
+{
+    check_track_changes();
+    return notification_->generation.load();
+}
+
+template <typename T, int SIZE>
+bool array<T, SIZE>::wait_for_update(uint index,
+                                     std::uint64_t last_seen,
+                                     long timeout_nano_seconds)
+{
+    check_track_changes();
+    if (index >= size_)
+    {
+        throw std::runtime_error("invalid index");
+    }
+    return internal::wait_for_generation(*notification_,
+                                         element_stamps(index).generation,
+                                         last_seen,
+                                         timeout_nano_seconds);
+}
+
+template <typename T, int SIZE>
+bool array<T, SIZE>::wait_for_any_update(std::uint64_t last_seen,
+                                         long timeout_nano_seconds)
+{
+    check_track_changes();
+    return internal::wait_for_generation(*notification_,
+                                         notification_->generation,
+                                         last_seen,
+                                         timeout_nano_seconds);
+}
+
+template <typename T, int SIZE>
+template <typename Callback>
+std::uint64_t array<T, SIZE>::get_changed_since(std::uint64_t epoch,
+                                                Callback callback)
+{
+    check_track_changes();
+    std::size_t item_values = SIZE == 0 ? 1 : SIZE;
+    changed_indexes_.clear();
+
+    // copying the written elements under a single lock of the array,
+    // calling callback after
+    if (multiprocess_safe_)
+    {
+        mapping_->mutex.lock();
+    }
+    // stamps of the writes counted by this generation are all set
+    std::uint64_t current = notification_->generation.load();
+    for (std::size_t block = 0; block < get_nb_blocks(); block++)
+    {
+        if (block_stamp(block).load(std::memory_order_acquire) <= epoch)
+        {
+            continue;
+        }
+        std::size_t end =
+            std::min(size_, (block + 1) * internal::ARRAY_BLOCK_SIZE);
+        for (std::size_t index = block * internal::ARRAY_BLOCK_SIZE;
+             index < end;
+             index++)
+        {
+            if (element_stamps(index).updated_at.load(
+                    std::memory_order_acquire) > epoch)
+            {
+                changed_indexes_.push_back(static_cast<uint>(index));
+            }
+        }
+    }
+    if (changed_items_.size() < changed_indexes_.size() * item_values)
+    {
+        changed_items_.resize(changed_indexes_.size() * item_values);
+    }
+    for (std::size_t i = 0; i < changed_indexes_.size(); i++)
+    {
+        copy_item(changed_indexes_[i],
+                  changed_items_[i * item_values],
+                  this->type_);
+    }
+    if (multiprocess_safe_)
+    {
+        mapping_->mutex.unlock();
+    }
+
+    for (std::size_t i = 0; i < changed_indexes_.size(); i++)
+    {
+        callback(changed_indexes_[i], changed_items_[i * item_values]);
+    }
+    return current;
+}
+
+template <typename T, int SIZE>
+std::size_t array<T, SIZE>::get_slot_size(std::size_t item_size) const
+{
+    if (!padded_slots_)
+    {
+        return item_size;
+    }
+    return ((item_size + internal::CACHE_LINE_SIZE - 1) /
+            internal::CACHE_LINE_SIZE) *
+           internal::CACHE_LINE_SIZE;
+}
+
+template <typename T, int SIZE>
+char* array<T, SIZE>::init_slots(std::size_t item_size)
+{
+    // if the segment already exists, using the layout of its creator
+    bool sequences = sync_ == ARRAY_SINGLE_WRITER;
+    internal::ArrayLayout* layout =
+        mapping_->segment.find_or_construct<internal::ArrayLayout>(
+            (segment_id_ + std::string("_layout")).c_str())(
+            get_slot_size(item_size), padded_slots_, sequences, track_changes_);
+    if (layout->sequences != sequences)
+    {
+        // the segment is used by other arrays: not wiping it
+        mapping_->clear_on_destruction = false;
+        throw std::runtime_error(
+            "array: the segment " + segment_id_ + " has been created " +
+            (layout->sequences ? "with" : "without") +
+            " the synchronization ARRAY_SINGLE_WRITER, the array " +
+            (sequences ? "uses it" : "does not use it"));
+    }
+    slot_size_ = layout->slot_size;
+    padded_slots_ = layout->padded_slots;
+    track_changes_ = layout->track_changes;
+
+    // one more cache line for aligning the first slot
+    return internal::align_to_cache_line(
+        mapping_->segment.find_or_construct<char>(
+            segment_id_.c_str())[size_ * slot_size_ +
+                                 internal::CACHE_LINE_SIZE](0));
+}
+
+template <typename T, int SIZE>
+char* array<T, SIZE>::slot(uint index) const
+{
+    return reinterpret_cast<char*>(this->shared_) + index * slot_size_;
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::write_slots(uint begin,
+                                 const void* items,
+                                 std::size_t span,
+                                 std::size_t item_size)
+{
+    if (slot_size_ == item_size)
+    {
+        std::memcpy(slot(begin), items, span * item_size);
+        return;
+    }
+    const char* source = static_cast<const char*>(items);
+    for (std::size_t i = 0; i < span; i++)
+    {
+        std::memcpy(slot(begin + i), source + i * item_size, item_size);
+    }
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::read_slots(uint begin,
+                                void* items,
+                                std::size_t span,
+                                std::size_t item_size) const
+{
+    if (slot_size_ == item_size)
+    {
+        std::memcpy(items, slot(begin), span * item_size);
+        return;
+    }
+    char* destination = static_cast<char*>(items);
+    for (std::size_t i = 0; i < span; i++)
+    {
+        std::memcpy(destination + i * item_size, slot(begin + i), item_size);
+    }
+}
+
+template <typename T, int SIZE>
+array<T, SIZE>::~array()
+{
+    // the segment is wiped (if requested) by the mapping, once its last
+    // copy is destroyed
 }
 
 template <typename T, int SIZE>
 void array<T, SIZE>::set(uint index, const T& t)
 {
     set(index, t, this->type_);
+    notify_update();
 }
 
 template <typename T, int SIZE>
 void array<T, SIZE>::set(uint index, const T* t)
 {
     set(index, *t, this->type_);
+    notify_update();
 }
 
 template <typename T, int SIZE>
@@ -99,6 +451,45 @@ void array<T, SIZE>::get(uint index, T* t)
     get(index, *t, this->type_);
 }
 
+template <typename T, int SIZE>
+void array<T, SIZE>::set_range(uint begin, const T* t, std::size_t span)
+{
+    if (begin + span > size_)
+    {
+        throw std::runtime_error("invalid index");
+    }
+    set_range(begin, t, span, this->type_);
+    notify_update();
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::get_range(uint begin, T* t, std::size_t span)
+{
+    if (begin + span > size_)
+    {
+        throw std::runtime_error("invalid index");
+    }
+    get_range(begin, t, span, this->type_);
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::set_all(const std::vector<T>& values)
+{
+    std::size_t items_size = SIZE == 0 ? size_ : size_ * SIZE;
+    if (values.size() != items_size)
+    {
+        throw std::runtime_error("invalid size");
+    }
+    set_range(0, values.data(), size_);
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::get_all(std::vector<T>& values)
+{
+    values.resize(SIZE == 0 ? size_ : size_ * SIZE);
+    get_range(0, values.data(), size_);
+}
+
 template <typename T, int SIZE>
 std::string array<T, SIZE>::get_serialized(uint index)
 {
@@ -108,8 +499,16 @@ std::string array<T, SIZE>::get_serialized(uint index)
 template <typename T, int SIZE>
 void array<T, SIZE>::print()
 {
-    SegmentInfo si(segment_manager_);
+    SegmentInfo si(mapping_->segment);
     si.print();
+    // the segment is created at the size of the objects of the array,
+    // but mapped in whole pages
+    std::size_t page_size = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+    std::size_t last_page = si.get_size() % page_size;
+    std::cout << "\twasted:\t" << si.get_free_memory()
+              << " (free), "
+              << (last_page == 0 ? 0 : page_size - last_page)
+              << " (end of last page)" << std::endl;
 }
 
 template <typename T, int SIZE>
@@ -118,6 +517,12 @@ std::size_t array<T, SIZE>::size() const
     return size_;
 }
 
+template <typename T, int SIZE>
+bool array<T, SIZE>::get_huge_pages() const
+{
+    return mapping_->huge_pages;
+}
+
 template <typename T, int SIZE>
 void* array<T, SIZE>::get_raw()
 {
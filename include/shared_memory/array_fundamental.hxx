@@ -4,11 +4,7 @@
 template <typename T, int SIZE>
 void array<T, SIZE>::init(FUNDAMENTAL)
 {
-    uint segment_size = get_segment_size(size_, sizeof(T));
-    segment_manager_ = boost::interprocess::managed_shared_memory(
-        boost::interprocess::open_or_create, segment_id_.c_str(), segment_size);
-    this->shared_ = segment_manager_.find_or_construct<T>(
-        segment_id_.c_str())[this->size_]();
+    this->shared_ = reinterpret_cast<T*>(init_segment(sizeof(T)));
 }
 
 template <typename T, int SIZE>
@@ -18,18 +14,41 @@ void array<T, SIZE>::set(uint index, const T& t, FUNDAMENTAL)
     {
         throw std::runtime_error("invalid index");
     }
+    T* item = reinterpret_cast<T*>(slot(index));
+    if (this->sequences_ != nullptr)
+    {
+        internal::seqlock_begin_write(&this->sequences_[index], 1);
+        *item = t;
+        internal::seqlock_end_write(&this->sequences_[index], 1);
+        publish_update(index, 1);
+        return;
+    }
     if (multiprocess_safe_)
     {
-        this->mutex_.lock();
+        this->mapping_->mutex.lock();
     }
-    this->shared_[index] = t;
+    *item = t;
+    publish_update(index, 1);
     if (multiprocess_safe_)
     {
-        this->mutex_.unlock();
+        this->mapping_->mutex.unlock();
     }
     return;
 }
 
+template <typename T, int SIZE>
+void array<T, SIZE>::copy_item(uint index, T& t, FUNDAMENTAL)
+{
+    const T* item = reinterpret_cast<const T*>(slot(index));
+    if (this->sequences_ != nullptr)
+    {
+        internal::seqlock_read(
+            &this->sequences_[index], 1, [&]() { t = *item; });
+        return;
+    }
+    t = *item;
+}
+
 template <typename T, int SIZE>
 void array<T, SIZE>::get(uint index, T& t, FUNDAMENTAL)
 {
@@ -39,12 +58,62 @@ void array<T, SIZE>::get(uint index, T& t, FUNDAMENTAL)
     }
     if (multiprocess_safe_)
     {
-        this->mutex_.lock();
+        this->mapping_->mutex.lock();
+    }
+    copy_item(index, t, this->type_);
+    if (multiprocess_safe_)
+    {
+        this->mapping_->mutex.unlock();
+    }
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::set_range(uint begin,
+                               const T* t,
+                               std::size_t span,
+                               FUNDAMENTAL)
+{
+    if (this->sequences_ != nullptr)
+    {
+        internal::seqlock_begin_write(&this->sequences_[begin], span);
+        write_slots(begin, t, span, sizeof(T));
+        internal::seqlock_end_write(&this->sequences_[begin], span);
+        publish_update(begin, span);
+        return;
+    }
+    if (multiprocess_safe_)
+    {
+        this->mapping_->mutex.lock();
+    }
+    write_slots(begin, t, span, sizeof(T));
+    publish_update(begin, span);
+    if (multiprocess_safe_)
+    {
+        this->mapping_->mutex.unlock();
+    }
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::get_range(uint begin,
+                               T* t,
+                               std::size_t span,
+                               FUNDAMENTAL)
+{
+    if (this->sequences_ != nullptr)
+    {
+        internal::seqlock_read(&this->sequences_[begin], span, [&]() {
+            read_slots(begin, t, span, sizeof(T));
+        });
+        return;
+    }
+    if (multiprocess_safe_)
+    {
+        this->mapping_->mutex.lock();
     }
-    t = this->shared_[index];
+    read_slots(begin, t, span, sizeof(T));
     if (multiprocess_safe_)
     {
-        this->mutex_.unlock();
+        this->mapping_->mutex.unlock();
     }
 }
 
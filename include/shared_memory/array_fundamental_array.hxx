@@ -6,12 +6,7 @@ void array<T, SIZE>::init(FUNDAMENTAL_ARRAY)
 {
     this->total_size_ = size_ * SIZE;
 
-    uint segment_size = get_segment_size(this->total_size_, sizeof(T));
-
-    segment_manager_ = boost::interprocess::managed_shared_memory(
-        boost::interprocess::open_or_create, segment_id_.c_str(), segment_size);
-    this->shared_ = segment_manager_.find_or_construct<T>(
-        segment_id_.c_str())[this->total_size_]();
+    this->shared_ = reinterpret_cast<T*>(init_segment(SIZE * sizeof(T)));
 }
 
 template <typename T, int SIZE>
@@ -21,19 +16,44 @@ void array<T, SIZE>::set(uint index, const T& t, FUNDAMENTAL_ARRAY)
     {
         throw std::runtime_error("invalid index");
     }
+    T* item = reinterpret_cast<T*>(slot(index));
+    if (this->sequences_ != nullptr)
+    {
+        internal::seqlock_begin_write(&this->sequences_[index], 1);
+        internal::copy(item, &t, SIZE);
+        internal::seqlock_end_write(&this->sequences_[index], 1);
+        publish_update(index, 1);
+        return;
+    }
     if (multiprocess_safe_)
     {
-        mutex_.lock();
+        mapping_->mutex.lock();
     }
-    uint abs_index = index * SIZE;
-    uint c = 0;
-    for (uint i = abs_index; i < abs_index + SIZE; i++)
+    for (uint i = 0; i < SIZE; i++)
     {
-        this->shared_[i] = (&t)[c++];
+        item[i] = (&t)[i];
     }
+    publish_update(index, 1);
     if (multiprocess_safe_)
     {
-        mutex_.unlock();
+        mapping_->mutex.unlock();
+    }
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::copy_item(uint index, T& t, FUNDAMENTAL_ARRAY)
+{
+    const T* item = reinterpret_cast<const T*>(slot(index));
+    if (this->sequences_ != nullptr)
+    {
+        internal::seqlock_read(&this->sequences_[index], 1, [&]() {
+            internal::copy(&t, item, SIZE);
+        });
+        return;
+    }
+    for (uint i = 0; i < SIZE; i++)
+    {
+        (&t)[i] = item[i];
     }
 }
 
@@ -46,17 +66,62 @@ void array<T, SIZE>::get(uint index, T& t, FUNDAMENTAL_ARRAY)
     }
     if (multiprocess_safe_)
     {
-        mutex_.lock();
+        mapping_->mutex.lock();
+    }
+    copy_item(index, t, this->type_);
+    if (multiprocess_safe_)
+    {
+        mapping_->mutex.unlock();
     }
-    uint abs_index = index * SIZE;
-    uint c = 0;
-    for (uint i = abs_index; i < abs_index + SIZE; i++)
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::set_range(uint begin,
+                               const T* t,
+                               std::size_t span,
+                               FUNDAMENTAL_ARRAY)
+{
+    if (this->sequences_ != nullptr)
+    {
+        internal::seqlock_begin_write(&this->sequences_[begin], span);
+        write_slots(begin, t, span, SIZE * sizeof(T));
+        internal::seqlock_end_write(&this->sequences_[begin], span);
+        publish_update(begin, span);
+        return;
+    }
+    if (multiprocess_safe_)
+    {
+        mapping_->mutex.lock();
+    }
+    write_slots(begin, t, span, SIZE * sizeof(T));
+    publish_update(begin, span);
+    if (multiprocess_safe_)
+    {
+        mapping_->mutex.unlock();
+    }
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::get_range(uint begin,
+                               T* t,
+                               std::size_t span,
+                               FUNDAMENTAL_ARRAY)
+{
+    if (this->sequences_ != nullptr)
+    {
+        internal::seqlock_read(&this->sequences_[begin], span, [&]() {
+            read_slots(begin, t, span, SIZE * sizeof(T));
+        });
+        return;
+    }
+    if (multiprocess_safe_)
     {
-        (&t)[c++] = this->shared_[i];
+        mapping_->mutex.lock();
     }
+    read_slots(begin, t, span, SIZE * sizeof(T));
     if (multiprocess_safe_)
     {
-        mutex_.unlock();
+        mapping_->mutex.unlock();
     }
 }
 
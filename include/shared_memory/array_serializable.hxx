@@ -6,25 +6,16 @@ void array<T, SIZE>::init(SERIALIZABLE)
 {
     this->item_size_ = Serializer<T>::serializable_size();
     this->total_size_ = this->item_size_ * this->size_;
-    uint segment_size = get_segment_size(this->total_size_, sizeof(char));
-    segment_manager_ = boost::interprocess::managed_shared_memory(
-        boost::interprocess::open_or_create, segment_id_.c_str(), segment_size);
-    this->shared_ = segment_manager_.find_or_construct<char>(
-        segment_id_.c_str())[this->total_size_]();
+    this->shared_ = init_segment(this->item_size_);
 }
 
 template <typename T, int SIZE>
 void array<T, SIZE>::set(uint index, const T& t, SERIALIZABLE)
 {
-    uint abs_index = index * this->item_size_;
-    if (index >= this->total_size_)
+    if (index >= this->size_)
     {
         throw std::runtime_error("invalid index");
     }
-    if (multiprocess_safe_)
-    {
-        mutex_.lock();
-    }
 
     const std::string& serialized = this->serializer_.serialize(t);
 
@@ -38,52 +29,162 @@ void array<T, SIZE>::set(uint index, const T& t, SERIALIZABLE)
         throw std::runtime_error(msg.str());
     }
 
-    for (uint index = 0; index < this->item_size_; index++)
+    if (this->sequences_ != nullptr)
+    {
+        internal::seqlock_begin_write(&this->sequences_[index], 1);
+        std::memcpy(slot(index), serialized.data(), this->item_size_);
+        internal::seqlock_end_write(&this->sequences_[index], 1);
+        publish_update(index, 1);
+        return;
+    }
+
+    if (multiprocess_safe_)
     {
-        this->shared_[abs_index + index] = serialized[index];
+        mapping_->mutex.lock();
     }
+    std::memcpy(slot(index), serialized.data(), this->item_size_);
+    publish_update(index, 1);
     if (multiprocess_safe_)
     {
-        mutex_.unlock();
+        mapping_->mutex.unlock();
+    }
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::copy_item(uint index, T& t, SERIALIZABLE)
+{
+    if (this->sequences_ != nullptr)
+    {
+        // copying the item, deserializing after
+        this->range_.resize(this->item_size_);
+        internal::seqlock_read(&this->sequences_[index], 1, [&]() {
+            std::memcpy(&this->range_[0], slot(index), this->item_size_);
+        });
+        this->serializer_.deserialize(
+            this->range_.data(), this->item_size_, t);
+        return;
     }
+    this->serializer_.deserialize(slot(index), this->item_size_, t);
 }
 
 template <typename T, int SIZE>
 void array<T, SIZE>::get(uint index, T& t, SERIALIZABLE)
 {
-    uint abs_index = index * this->item_size_;
-    if (abs_index >= this->total_size_)
+    if (index >= this->size_)
     {
         throw std::runtime_error("invalid index");
     }
     if (multiprocess_safe_)
     {
-        mutex_.lock();
+        mapping_->mutex.lock();
     }
-    this->serializer_.deserialize(
-        std::string(&this->shared_[abs_index], this->item_size_), t);
+    copy_item(index, t, this->type_);
     if (multiprocess_safe_)
     {
-        mutex_.unlock();
+        mapping_->mutex.unlock();
+    }
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::set_range(uint begin,
+                               const T* t,
+                               std::size_t span,
+                               SERIALIZABLE)
+{
+    // serializing before locking, so that the lock is held
+    // only for copying
+    this->range_.resize(span * this->item_size_);
+    for (std::size_t i = 0; i < span; i++)
+    {
+        const std::string& serialized = this->serializer_.serialize(t[i]);
+        if (serialized.size() != this->item_size_)
+        {
+            std::stringstream msg;
+            msg << "Serialized object has unexpected size "
+                << serialized.size() << " (expected " << this->item_size_
+                << ").  Please note that only fixed-size types are supported.";
+            throw std::runtime_error(msg.str());
+        }
+        std::memcpy(&this->range_[i * this->item_size_],
+                    serialized.data(),
+                    serialized.size());
+    }
+    if (this->sequences_ != nullptr)
+    {
+        internal::seqlock_begin_write(&this->sequences_[begin], span);
+        write_slots(begin, this->range_.data(), span, this->item_size_);
+        internal::seqlock_end_write(&this->sequences_[begin], span);
+        publish_update(begin, span);
+        return;
+    }
+    if (multiprocess_safe_)
+    {
+        mapping_->mutex.lock();
+    }
+    write_slots(begin, this->range_.data(), span, this->item_size_);
+    publish_update(begin, span);
+    if (multiprocess_safe_)
+    {
+        mapping_->mutex.unlock();
+    }
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::get_range(uint begin,
+                               T* t,
+                               std::size_t span,
+                               SERIALIZABLE)
+{
+    // copying under lock, deserializing after
+    this->range_.resize(span * this->item_size_);
+    if (this->sequences_ != nullptr)
+    {
+        internal::seqlock_read(&this->sequences_[begin], span, [&]() {
+            read_slots(begin, &this->range_[0], span, this->item_size_);
+        });
+    }
+    else
+    {
+        if (multiprocess_safe_)
+        {
+            mapping_->mutex.lock();
+        }
+        read_slots(begin, &this->range_[0], span, this->item_size_);
+        if (multiprocess_safe_)
+        {
+            mapping_->mutex.unlock();
+        }
+    }
+    for (std::size_t i = 0; i < span; i++)
+    {
+        this->serializer_.deserialize(
+            &this->range_[i * this->item_size_], this->item_size_, t[i]);
     }
 }
 
 template <typename T, int SIZE>
 std::string array<T, SIZE>::get_serialized(uint index, SERIALIZABLE)
 {
-    uint abs_index = index * this->item_size_;
-    if (abs_index >= this->total_size_)
+    if (index >= this->size_)
     {
         throw std::runtime_error("invalid index");
     }
+    if (this->sequences_ != nullptr)
+    {
+        std::string r(this->item_size_, '\0');
+        internal::seqlock_read(&this->sequences_[index], 1, [&]() {
+            std::memcpy(&r[0], slot(index), this->item_size_);
+        });
+        return r;
+    }
     if (multiprocess_safe_)
     {
-        mutex_.lock();
+        mapping_->mutex.lock();
     }
-    std::string r(&this->shared_[abs_index], this->item_size_);
+    std::string r(slot(index), this->item_size_);
     if (multiprocess_safe_)
     {
-        mutex_.unlock();
+        mapping_->mutex.unlock();
     }
     return r;
 }
@@ -0,0 +1,134 @@
+// Copyright (c) 2019 Max Planck Gesellschaft
+// Author : Vincent Berenz
+
+template <typename T, int SIZE>
+void array<T, SIZE>::init(TRIVIALLY_COPYABLE)
+{
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "shared_memory::array does not support over-aligned types");
+
+    // items are only copied in and out with memcpy: the slots are (zeroed)
+    // raw memory, so that T does not have to be default constructible
+    this->shared_ = reinterpret_cast<T*>(init_segment(sizeof(T)));
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::set(uint index, const T& t, TRIVIALLY_COPYABLE)
+{
+    if (index >= this->size_)
+    {
+        throw std::runtime_error("invalid index");
+    }
+    if (this->sequences_ != nullptr)
+    {
+        internal::seqlock_begin_write(&this->sequences_[index], 1);
+        std::memcpy(slot(index), &t, sizeof(T));
+        internal::seqlock_end_write(&this->sequences_[index], 1);
+        publish_update(index, 1);
+        return;
+    }
+    if (multiprocess_safe_)
+    {
+        mapping_->mutex.lock();
+    }
+    std::memcpy(slot(index), &t, sizeof(T));
+    publish_update(index, 1);
+    if (multiprocess_safe_)
+    {
+        mapping_->mutex.unlock();
+    }
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::copy_item(uint index, T& t, TRIVIALLY_COPYABLE)
+{
+    if (this->sequences_ != nullptr)
+    {
+        internal::seqlock_read(&this->sequences_[index], 1, [&]() {
+            std::memcpy(&t, slot(index), sizeof(T));
+        });
+        return;
+    }
+    std::memcpy(&t, slot(index), sizeof(T));
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::get(uint index, T& t, TRIVIALLY_COPYABLE)
+{
+    if (index >= this->size_)
+    {
+        throw std::runtime_error("invalid index");
+    }
+    if (multiprocess_safe_)
+    {
+        mapping_->mutex.lock();
+    }
+    copy_item(index, t, this->type_);
+    if (multiprocess_safe_)
+    {
+        mapping_->mutex.unlock();
+    }
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::set_range(uint begin,
+                               const T* t,
+                               std::size_t span,
+                               TRIVIALLY_COPYABLE)
+{
+    if (this->sequences_ != nullptr)
+    {
+        internal::seqlock_begin_write(&this->sequences_[begin], span);
+        write_slots(begin, t, span, sizeof(T));
+        internal::seqlock_end_write(&this->sequences_[begin], span);
+        publish_update(begin, span);
+        return;
+    }
+    if (multiprocess_safe_)
+    {
+        mapping_->mutex.lock();
+    }
+    write_slots(begin, t, span, sizeof(T));
+    publish_update(begin, span);
+    if (multiprocess_safe_)
+    {
+        mapping_->mutex.unlock();
+    }
+}
+
+template <typename T, int SIZE>
+void array<T, SIZE>::get_range(uint begin,
+                               T* t,
+                               std::size_t span,
+                               TRIVIALLY_COPYABLE)
+{
+    if (this->sequences_ != nullptr)
+    {
+        internal::seqlock_read(&this->sequences_[begin], span, [&]() {
+            read_slots(begin, t, span, sizeof(T));
+        });
+        return;
+    }
+    if (multiprocess_safe_)
+    {
+        mapping_->mutex.lock();
+    }
+    read_slots(begin, t, span, sizeof(T));
+    if (multiprocess_safe_)
+    {
+        mapping_->mutex.unlock();
+    }
+}
+
+template <typename T, int SIZE>
+std::string array<T, SIZE>::get_serialized(uint index, TRIVIALLY_COPYABLE)
+{
+    // compiles only if T implements a serializable function. The item
+    // is copied into raw storage, so that T does not have to be default
+    // constructible
+    alignas(T) char storage[sizeof(T)];
+    T& t = *reinterpret_cast<T*>(storage);
+    get(index, t, this->type_);
+    Serializer<T> serializer;
+    return serializer.serialize(t);
+}
@@ -0,0 +1,156 @@
+/**
+ * @file batch.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2019, New York University and Max Planck
+ * Gesellschaft.
+ *
+ * @brief Declares a batch of sets and gets of objects of a shared memory
+ * segment, performed under a single lock of the segment mutex.
+ */
+
+#pragma once
+
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Dense>
+
+namespace shared_memory
+{
+class SharedMemorySegment;
+
+/**
+ * @brief A Batch queues sets and gets of objects of a segment, which are
+ * all performed by commit while the segment mutex is locked once. Processes
+ * getting the objects (via set/get or via another batch) therefore never
+ * observe a batch partially applied. Objects created with a policy other
+ * than SEGMENT_MUTEX (see ObjectSync) are read and written without locking
+ * the segment mutex, and are thus not part of this guarantee. Their mutex
+ * (OBJECT_MUTEX, or SEQLOCK writers) is locked by commit while the segment
+ * mutex is held: a thread owning a ReadView of an OBJECT_MUTEX object of the
+ * segment must not commit a batch (see the lock order in ObjectSync).
+ *
+ * The batch stores the addresses of the values passed to set and get:
+ * they must remain valid until commit is called. A batch can be reused
+ * once committed. Sets and gets not committed are discarded when the batch
+ * is destroyed.
+ *
+ * Instances are obtained via shared_memory::begin_batch.
+ */
+class Batch
+{
+public:
+    /**
+     * @brief to be called via shared_memory::begin_batch
+     */
+    explicit Batch(SharedMemorySegment& segment);
+
+    /**
+     * @brief queues the writing of a single value
+     */
+    template <typename ElemType>
+    void set(const std::string& object_id, const ElemType& set_);
+
+    /**
+     * @brief queues the writing of size items
+     */
+    template <typename ElemType>
+    void set(const std::string& object_id,
+             const ElemType* set_,
+             std::size_t size);
+
+    template <typename ElemType>
+    void set(const std::string& object_id, const std::vector<ElemType>& set_);
+
+    template <typename ElemType>
+    void set(const std::string& object_id,
+             const Eigen::Matrix<ElemType, Eigen::Dynamic, 1>& set_);
+
+    void set(const std::string& object_id, const std::string& set_);
+
+    /**
+     * @brief queues the writing of the pair, with the same object ids as
+     * shared_memory::set
+     */
+    template <typename FirstType, typename SecondType>
+    void set(const std::string& object_id,
+             const std::pair<FirstType, SecondType>& set_);
+
+    /**
+     * @brief queues the writing of the values of the map, with the same
+     * object ids as shared_memory::set
+     */
+    template <typename KeyType, typename ValueType>
+    void set(const std::string& object_id,
+             const std::map<KeyType, ValueType>& set_);
+
+    /**
+     * @brief queues the reading of a single value
+     */
+    template <typename ElemType>
+    void get(const std::string& object_id, ElemType& get_);
+
+    /**
+     * @brief queues the reading of size items. Commit throws an
+     * Unexpected_size_exception if the object is not of this size.
+     */
+    template <typename ElemType>
+    void get(const std::string& object_id, ElemType* get_, std::size_t size);
+
+    template <typename ElemType>
+    void get(const std::string& object_id, std::vector<ElemType>& get_);
+
+    template <typename ElemType>
+    void get(const std::string& object_id,
+             Eigen::Matrix<ElemType, Eigen::Dynamic, 1>& get_);
+
+    void get(const std::string& object_id, std::string& get_);
+
+    template <typename FirstType, typename SecondType>
+    void get(const std::string& object_id,
+             std::pair<FirstType, SecondType>& get_);
+
+    template <typename KeyType, typename ValueType>
+    void get(const std::string& object_id, std::map<KeyType, ValueType>& get_);
+
+    /**
+     * @brief performs all queued sets and gets (in the order they have been
+     * queued) while holding the segment mutex, then empties the batch.
+     */
+    void commit();
+
+    /**
+     * @brief number of sets and gets queued since the last commit
+     */
+    std::size_t size() const;
+
+private:
+    struct Operation
+    {
+        std::string object_id;
+        // value to write (set) or to read into (get)
+        void* data;
+        std::size_t size;
+        // called by commit, with the segment mutex locked
+        void (*apply)(SharedMemorySegment& segment,
+                      const Operation& operation);
+    };
+
+    template <typename ElemType>
+    static void apply_set(SharedMemorySegment& segment,
+                          const Operation& operation);
+
+    template <typename ElemType>
+    static void apply_get(SharedMemorySegment& segment,
+                          const Operation& operation);
+
+    static void apply_get_string(SharedMemorySegment& segment,
+                                 const Operation& operation);
+
+    SharedMemorySegment* segment_;
+    std::vector<Operation> operations_;
+};
+
+}  // namespace shared_memory
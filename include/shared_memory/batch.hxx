@@ -0,0 +1,134 @@
+/**
+ * @file batch.hxx
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2019, New York University and Max Planck
+ * Gesellschaft.
+ *
+ * @brief Implements the template methods of Batch
+ */
+
+template <typename ElemType>
+void Batch::set(const std::string& object_id, const ElemType& set_)
+{
+    set(object_id, &set_, 1);
+}
+
+template <typename ElemType>
+void Batch::set(const std::string& object_id,
+                const ElemType* set_,
+                std::size_t size)
+{
+    Operation operation;
+    operation.object_id = object_id;
+    operation.data = const_cast<ElemType*>(set_);
+    operation.size = size;
+    operation.apply = &Batch::apply_set<ElemType>;
+    operations_.push_back(operation);
+}
+
+template <typename ElemType>
+void Batch::set(const std::string& object_id,
+                const std::vector<ElemType>& set_)
+{
+    set(object_id, set_.data(), set_.size());
+}
+
+template <typename ElemType>
+void Batch::set(const std::string& object_id,
+                const Eigen::Matrix<ElemType, Eigen::Dynamic, 1>& set_)
+{
+    set(object_id, set_.data(), set_.size());
+}
+
+template <typename FirstType, typename SecondType>
+void Batch::set(const std::string& object_id,
+                const std::pair<FirstType, SecondType>& set_)
+{
+    set(object_id + "_first", set_.first);
+    set(object_id + "_second", set_.second);
+}
+
+template <typename KeyType, typename ValueType>
+void Batch::set(const std::string& object_id,
+                const std::map<KeyType, ValueType>& set_)
+{
+    int i = 0;
+    for (typename std::map<KeyType, ValueType>::const_iterator map_it =
+             set_.begin();
+         map_it != set_.end();
+         ++map_it)
+    {
+        set(object_id + "_" + std::to_string(i), map_it->second);
+        ++i;
+    }
+}
+
+template <typename ElemType>
+void Batch::get(const std::string& object_id, ElemType& get_)
+{
+    get(object_id, &get_, 1);
+}
+
+template <typename ElemType>
+void Batch::get(const std::string& object_id,
+                ElemType* get_,
+                std::size_t size)
+{
+    Operation operation;
+    operation.object_id = object_id;
+    operation.data = get_;
+    operation.size = size;
+    operation.apply = &Batch::apply_get<ElemType>;
+    operations_.push_back(operation);
+}
+
+template <typename ElemType>
+void Batch::get(const std::string& object_id, std::vector<ElemType>& get_)
+{
+    get(object_id, get_.data(), get_.size());
+}
+
+template <typename ElemType>
+void Batch::get(const std::string& object_id,
+                Eigen::Matrix<ElemType, Eigen::Dynamic, 1>& get_)
+{
+    get(object_id, get_.data(), get_.size());
+}
+
+template <typename FirstType, typename SecondType>
+void Batch::get(const std::string& object_id,
+                std::pair<FirstType, SecondType>& get_)
+{
+    get(object_id + "_first", get_.first);
+    get(object_id + "_second", get_.second);
+}
+
+template <typename KeyType, typename ValueType>
+void Batch::get(const std::string& object_id,
+                std::map<KeyType, ValueType>& get_)
+{
+    int i = 0;
+    for (typename std::map<KeyType, ValueType>::iterator map_it = get_.begin();
+         map_it != get_.end();
+         ++map_it)
+    {
+        get(object_id + "_" + std::to_string(i), map_it->second);
+        ++i;
+    }
+}
+
+template <typename ElemType>
+void Batch::apply_set(SharedMemorySegment& segment, const Operation& operation)
+{
+    std::pair<const ElemType*, std::size_t> set_(
+        static_cast<const ElemType*>(operation.data), operation.size);
+    segment.set_object_locked<ElemType>(operation.object_id, set_);
+}
+
+template <typename ElemType>
+void Batch::apply_get(SharedMemorySegment& segment, const Operation& operation)
+{
+    std::pair<ElemType*, std::size_t> get_(
+        static_cast<ElemType*>(operation.data), operation.size);
+    segment.get_object_locked<ElemType>(operation.object_id, get_);
+}
@@ -0,0 +1,100 @@
+/**
+ * @file exchange_manager_broadcast_consumer.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2019, New York University and Max Planck
+ * Gesellschaft.
+ *
+ * @brief Interprocess broadcast of serialized items to several consumers
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "shared_memory/internal/exchange_manager_broadcast_memory.hpp"
+
+namespace shared_memory
+{
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+class Exchange_manager_broadcast_consumer
+{
+    typedef internal::
+        Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>
+            Memory;
+    typedef std::shared_ptr<Memory> Memory_ptr;
+
+public:
+    /**
+     * @brief An exchange_manager_broadcast_consumer reads from the shared
+     * memory the serialized items set by an instance of
+     * exchange_manager_broadcast_producer (which should use the same
+     * segment_id and object_id) after its construction, independently
+     * of the other consumers.
+     * @param segment_id id of the shared memory segment
+     * @param object_id id of the shared memory object prefix
+     * @param consumer index of this consumer (the producer gets the
+     * feedback of the items consumed by each consumer by index). Throws
+     * a std::runtime_error if not smaller than NB_CONSUMERS, or if another
+     * consumer is attached with the same index.
+     */
+    Exchange_manager_broadcast_consumer(std::string segment_id,
+                                        std::string object_id,
+                                        int consumer);
+
+    /**
+     * @brief detach the consumer, which no longer prevents the
+     * producer from writing items
+     */
+    ~Exchange_manager_broadcast_consumer();
+
+    /** @brief read from the underlying shared memory
+     *  the oldest serialized object not read by this consumer yet.
+     *  @return true if an item has been read
+     */
+    bool consume(Serializable &serializable);
+
+    /** @brief read up to max_items serialized objects (in the order they
+     *  were set). The ids of the items read are fed back to the producer
+     *  together.
+     *  @return the number of items read into serializables
+     */
+    std::size_t consume_batch(Serializable *serializables,
+                              std::size_t max_items);
+
+    /** @brief see consume_batch(Serializable*, std::size_t). The items
+     *  read are appended to serializables
+     */
+    std::size_t consume_batch(std::vector<Serializable> &serializables,
+                              std::size_t max_items);
+
+    /** @brief wait until the producer set items not consumed yet by this
+     *  consumer, without polling. A timeout (in nanoseconds) is advised,
+     *  no timeout if negative.
+     *  @return false if the timeout expired (or if this consumer is
+     *  not attached)
+     */
+    bool wait_for_items(long timeout_nano_seconds = -1);
+
+    /** @brief false if the producer dropped this consumer (see
+     *  Exchange_manager_broadcast_producer::drop_consumer), in which case
+     *  consume no longer reads items. To consume again, a new consumer
+     *  has to be constructed.
+     */
+    bool attached() const;
+
+    /** @brief attempts to write the buffered ids of consumed items (see
+     *  Exchange_manager_consumer::purge_feedbacks), returns true if all
+     *  have been written (or discarded, once dropped)
+     */
+    bool purge_feedbacks();
+
+private:
+    Memory_ptr memory_;
+    std::vector<int> ids_;
+};
+
+#include "exchange_manager_broadcast_consumer.hxx"
+
+}  // namespace shared_memory
@@ -0,0 +1,85 @@
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+Exchange_manager_broadcast_consumer<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    Exchange_manager_broadcast_consumer(std::string segment_id,
+                                        std::string object_id,
+                                        int consumer)
+    : memory_(new Memory(segment_id, object_id))
+{
+    memory_->attach(consumer);
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+Exchange_manager_broadcast_consumer<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    ~Exchange_manager_broadcast_consumer()
+{
+    memory_->detach();
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+bool Exchange_manager_broadcast_consumer<Serializable,
+                                         QUEUE_SIZE,
+                                         NB_CONSUMERS>::
+    consume(Serializable &serializable)
+{
+    return consume_batch(&serializable, 1) == 1;
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+std::size_t Exchange_manager_broadcast_consumer<Serializable,
+                                                QUEUE_SIZE,
+                                                NB_CONSUMERS>::
+    consume_batch(Serializable *serializables, std::size_t max_items)
+{
+    // not locking: only this consumer moves its position in the records
+    std::size_t nb_read = memory_->read_serialized(serializables, max_items);
+    if (nb_read > 0)
+    {
+        ids_.resize(nb_read);
+        for (std::size_t i = 0; i < nb_read; i++)
+        {
+            ids_[i] = serializables[i].get_id();
+        }
+        memory_->write_serialized_ids(ids_);
+    }
+    return nb_read;
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+std::size_t Exchange_manager_broadcast_consumer<Serializable,
+                                                QUEUE_SIZE,
+                                                NB_CONSUMERS>::
+    consume_batch(std::vector<Serializable> &serializables,
+                  std::size_t max_items)
+{
+    std::size_t previous_size = serializables.size();
+    serializables.resize(previous_size + max_items);
+    std::size_t nb_read =
+        consume_batch(serializables.data() + previous_size, max_items);
+    serializables.resize(previous_size + nb_read);
+    return nb_read;
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+bool Exchange_manager_broadcast_consumer<Serializable,
+                                         QUEUE_SIZE,
+                                         NB_CONSUMERS>::
+    wait_for_items(long timeout_nano_seconds)
+{
+    return memory_->wait_for_items(timeout_nano_seconds);
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+bool Exchange_manager_broadcast_consumer<Serializable,
+                                         QUEUE_SIZE,
+                                         NB_CONSUMERS>::attached() const
+{
+    return memory_->attached();
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+bool Exchange_manager_broadcast_consumer<Serializable,
+                                         QUEUE_SIZE,
+                                         NB_CONSUMERS>::purge_feedbacks()
+{
+    return memory_->purge_feedbacks();
+}
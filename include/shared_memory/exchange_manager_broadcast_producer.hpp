@@ -0,0 +1,121 @@
+/**
+ * @file exchange_manager_broadcast_producer.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2019, New York University and Max Planck
+ * Gesellschaft.
+ *
+ * @brief Interprocess broadcast of serialized items to several consumers
+ */
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "shared_memory/internal/exchange_manager_broadcast_memory.hpp"
+
+namespace shared_memory
+{
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+class Exchange_manager_broadcast_producer
+{
+    typedef internal::
+        Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>
+            Memory;
+    typedef std::shared_ptr<Memory> Memory_ptr;
+
+public:
+    /**
+     * @brief An exchange_manager_broadcast_producer writes in the shared
+     * memory serialized items, each read by all the instances of
+     * exchange_manager_broadcast_consumer attached to the same segment_id
+     * and object_id (up to NB_CONSUMERS, possibly running in separate
+     * processes). Items are serialized and copied in the shared memory
+     * once, whatever the number of consumers. Items set while no consumer
+     * is attached are not read.
+     * @param segment_id id of the shared memory segment
+     * @param object_id id of the shared memory object prefix
+     * @param drop_slow_consumers if false, items which can not be written
+     * because a consumer did not read the QUEUE_SIZE chars of items set
+     * before are buffered (see set). If true, such slow consumers are
+     * dropped instead (see Exchange_manager_broadcast_consumer::attached)
+     * @param clean_memory_on_exit if true, the destructor wipes the
+     * shared memory segment
+     */
+    Exchange_manager_broadcast_producer(std::string segment_id,
+                                        std::string object_id,
+                                        bool drop_slow_consumers = false,
+                                        bool clean_memory_on_exit = true);
+
+    ~Exchange_manager_broadcast_producer();
+
+    /** @brief Set this serializable to be consumed by all the attached
+     *  consumers. Returns true if the item could be written in the shared
+     *  memory, false if it required to be buffered because a consumer
+     *  is late (any following call to set, if any, will perform a new
+     *  attempt to write the buffer in the shared memory)
+     */
+    bool set(const Serializable &serializable);
+
+    /** @brief Set nb_items serializables to be consumed, in order,
+     *  publishing them to the consumers all at once (see set)
+     */
+    bool set_batch(const Serializable *serializables, std::size_t nb_items);
+
+    /** @brief see set_batch(const Serializable*, std::size_t)
+     */
+    bool set_batch(const std::vector<Serializable> &serializables);
+
+    /** @brief write into get_consumed_ids the ids of the serialized items
+     *  consumed by the consumer of index consumer since the last call.
+     *  Throws a std::runtime_error if consumer is not smaller than
+     *  NB_CONSUMERS
+     */
+    void get(int consumer, std::deque<int> &get_consumed_ids);
+
+    /** @brief number of attached consumers
+     */
+    std::size_t nb_consumers() const;
+
+    /** @brief write into slow_consumers the indexes of the attached
+     *  consumers which have lag items or more left to consume. Consumers
+     *  with QUEUE_SIZE chars of items left to consume prevent set from
+     *  writing (or are dropped, see the constructor)
+     */
+    void get_slow_consumers(std::size_t lag, std::vector<int> &slow_consumers);
+
+    /** @brief detach the consumer of index consumer, so that set no longer
+     *  waits for it to consume items. Throws a std::runtime_error if
+     *  consumer is not smaller than NB_CONSUMERS
+     */
+    void drop_consumer(int consumer);
+
+    /** @brief number of items the shared memory holds
+     */
+    std::size_t capacity() const;
+
+private:
+    Memory_ptr memory_;
+    bool drop_slow_consumers_;
+    bool clean_memory_on_exit_;
+    std::string segment_id_;
+
+public:
+    /** @brief (unlock) and erase the mutex from the shared
+     *  memory. To be used if some executable using the
+     *  exchange manager crashed without calls to destructors.
+     */
+    static void clean_mutex(std::string segment_id);
+
+    /** @brief wipe out the corresponding shared
+     *  memory. To be used if some executable using the
+     *  exchange manager crashed without calls to destructors.
+     */
+    static void clean_memory(std::string segment_id);
+};
+
+#include "exchange_manager_broadcast_producer.hxx"
+
+}  // namespace shared_memory
@@ -0,0 +1,127 @@
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+Exchange_manager_broadcast_producer<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    Exchange_manager_broadcast_producer(std::string segment_id,
+                                        std::string object_id,
+                                        bool drop_slow_consumers,
+                                        bool clean_memory_on_exit)
+    : memory_(new Memory(segment_id, object_id)),
+      drop_slow_consumers_(drop_slow_consumers),
+      clean_memory_on_exit_(clean_memory_on_exit),
+      segment_id_(segment_id)
+{
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+Exchange_manager_broadcast_producer<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    ~Exchange_manager_broadcast_producer()
+{
+    if (clean_memory_on_exit_)
+    {
+        memory_ = nullptr;
+        clean_mutex(segment_id_);
+        clean_memory(segment_id_);
+    }
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+bool Exchange_manager_broadcast_producer<Serializable,
+                                         QUEUE_SIZE,
+                                         NB_CONSUMERS>::
+    set(const Serializable &serializable)
+{
+    return set_batch(&serializable, 1);
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+bool Exchange_manager_broadcast_producer<Serializable,
+                                         QUEUE_SIZE,
+                                         NB_CONSUMERS>::
+    set_batch(const Serializable *serializables, std::size_t nb_items)
+{
+    // consumers attach under the mutex
+    bool everything_shared;
+    memory_->lock();
+    try
+    {
+        everything_shared = memory_->write_serialized(
+            serializables, nb_items, drop_slow_consumers_);
+    }
+    catch (const std::runtime_error &e)
+    {
+        memory_->unlock();
+        throw e;
+    }
+    memory_->unlock();
+    return everything_shared;
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+bool Exchange_manager_broadcast_producer<Serializable,
+                                         QUEUE_SIZE,
+                                         NB_CONSUMERS>::
+    set_batch(const std::vector<Serializable> &serializables)
+{
+    return set_batch(serializables.data(), serializables.size());
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_producer<Serializable,
+                                         QUEUE_SIZE,
+                                         NB_CONSUMERS>::
+    get(int consumer, std::deque<int> &get_consumed_ids)
+{
+    memory_->get_consumed_ids(consumer, get_consumed_ids);
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+std::size_t Exchange_manager_broadcast_producer<Serializable,
+                                                QUEUE_SIZE,
+                                                NB_CONSUMERS>::nb_consumers()
+    const
+{
+    return memory_->nb_consumers();
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_producer<Serializable,
+                                         QUEUE_SIZE,
+                                         NB_CONSUMERS>::
+    get_slow_consumers(std::size_t lag, std::vector<int> &slow_consumers)
+{
+    memory_->get_slow_consumers(lag, slow_consumers);
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_producer<Serializable,
+                                         QUEUE_SIZE,
+                                         NB_CONSUMERS>::
+    drop_consumer(int consumer)
+{
+    memory_->drop_consumer(consumer);
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+std::size_t Exchange_manager_broadcast_producer<Serializable,
+                                                QUEUE_SIZE,
+                                                NB_CONSUMERS>::capacity() const
+{
+    return memory_->capacity();
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_producer<Serializable,
+                                         QUEUE_SIZE,
+                                         NB_CONSUMERS>::
+    clean_mutex(std::string segment_id)
+{
+    Memory::clean_mutex(segment_id);
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_producer<Serializable,
+                                         QUEUE_SIZE,
+                                         NB_CONSUMERS>::
+    clean_memory(std::string segment_id)
+{
+    Memory::clean_memory(segment_id);
+}
@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include "shared_memory/internal/exchange_manager_memory.hpp"
 
 namespace bip = boost::interprocess;
@@ -67,11 +69,35 @@ public:
      */
     bool consume(Serializable &serializable);
 
+    /** @brief read from the underlying shared memory up to max_items
+     *  serialized objects (in the order they were set), locking the mutex
+     *  once (if autolock). The ids of the items read are fed back to the
+     *  producer together.
+     *  @return the number of items read into serializables
+     */
+    std::size_t consume_batch(Serializable *serializables,
+                              std::size_t max_items);
+
+    /** @brief see consume_batch(Serializable*, std::size_t). The items
+     *  read are appended to serializables
+     */
+    std::size_t consume_batch(std::vector<Serializable> &serializables,
+                              std::size_t max_items);
+
     /** @brief returns true if a producer is also running.
      *  'consume' should be called only if ready_to_consume returns true.
      */
     bool ready_to_consume();
 
+    /** @brief wait until a producer set items not consumed yet, without
+     *  polling: the producer wakes up the consumer when the queue is no
+     *  longer empty. Does not require to lock. A producer which dies
+     *  does not wake up the consumer: a timeout (in nanoseconds) is
+     *  advised, no timeout if negative.
+     *  @return false if the timeout expired
+     */
+    bool wait_for_items(long timeout_nano_seconds = -1);
+
     /** @brief When this instance consumes an item, the item id is written in a
      * shared queue for the producer to read (and acquire the feedback the item
      * has been consumed). This shared queue may get full (e.g the producer does
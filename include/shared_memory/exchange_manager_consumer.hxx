@@ -76,6 +76,13 @@ bool Exchange_manager_consumer<Serializable, QUEUE_SIZE>::ready_to_consume()
     return true;
 }
 
+template <class Serializable, int QUEUE_SIZE>
+bool Exchange_manager_consumer<Serializable, QUEUE_SIZE>::wait_for_items(
+    long timeout_nano_seconds)
+{
+    return memory_->wait_for_items(timeout_nano_seconds);
+}
+
 template <class Serializable, int QUEUE_SIZE>
 void Exchange_manager_consumer<Serializable, QUEUE_SIZE>::lock()
 {
@@ -140,6 +147,60 @@ bool Exchange_manager_consumer<Serializable, QUEUE_SIZE>::consume(
     return read;
 }
 
+template <class Serializable, int QUEUE_SIZE>
+std::size_t Exchange_manager_consumer<Serializable, QUEUE_SIZE>::consume_batch(
+    Serializable *serializables, std::size_t max_items)
+{
+    if (autolock_)
+    {
+        this->lock();
+    }
+
+    std::size_t nb_read = 0;
+    try
+    {
+        nb_read = memory_->read_serialized(serializables, max_items);
+    }
+    catch (const std::runtime_error &e)
+    {
+        if (autolock_)
+        {
+            memory_->unlock();
+        }
+
+        throw e;
+    }
+
+    if (nb_read > 0)
+    {
+        std::vector<int> ids(nb_read);
+        for (std::size_t i = 0; i < nb_read; i++)
+        {
+            ids[i] = serializables[i].get_id();
+        }
+        memory_->write_serialized_ids(ids);
+    }
+
+    if (autolock_)
+    {
+        this->unlock();
+    }
+
+    return nb_read;
+}
+
+template <class Serializable, int QUEUE_SIZE>
+std::size_t Exchange_manager_consumer<Serializable, QUEUE_SIZE>::consume_batch(
+    std::vector<Serializable> &serializables, std::size_t max_items)
+{
+    std::size_t previous_size = serializables.size();
+    serializables.resize(previous_size + max_items);
+    std::size_t nb_read =
+        consume_batch(serializables.data() + previous_size, max_items);
+    serializables.resize(previous_size + nb_read);
+    return nb_read;
+}
+
 template <class Serializable, int QUEUE_SIZE>
 int Exchange_manager_consumer<Serializable, QUEUE_SIZE>::nb_char_read()
 {
@@ -12,6 +12,8 @@
 #ifndef EXCHANGE_MANAGER_PRODUCER_HPP
 #define EXCHANGE_MANAGER_PRODUCER_HPP
 
+#include <vector>
+
 #include "shared_memory/internal/exchange_manager_memory.hpp"
 
 namespace bip = boost::interprocess;
@@ -77,6 +79,18 @@ public:
      */
     bool set(const Serializable &serializable);
 
+    /** @brief Set nb_items serializables to be consumed, in order. The
+     *  mutex is locked once (if autolock) and the items are published
+     *  to the consumer all at once.
+     *  Returns true if all items could be written in the shared memory,
+     *  false if some required to be buffered (see set)
+     */
+    bool set_batch(const Serializable *serializables, std::size_t nb_items);
+
+    /** @brief see set_batch(const Serializable*, std::size_t)
+     */
+    bool set_batch(const std::vector<Serializable> &serializables);
+
     /**
      * @brief removed all elements from the shared queue
      *
@@ -88,6 +102,15 @@ public:
      */
     void get(std::deque<int> &get_consumed_ids);
 
+    /** @brief wait until the consumer consumed items since the last call
+     *  to get, without polling: the consumer wakes up the producer when
+     *  writing the ids of the consumed items. Does not require to lock.
+     *  A consumer which dies does not wake up the producer: a timeout
+     *  (in nanoseconds) is advised, no timeout if negative.
+     *  @return false if the timeout expired
+     */
+    bool wait_for_feedback(long timeout_nano_seconds = -1);
+
     /** @brief returns the number of characters
      *  that have been serialized and written to
      *  the exchange queue. For debug purposes.
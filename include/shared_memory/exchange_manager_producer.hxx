@@ -132,6 +132,45 @@ bool Exchange_manager_producer<Serializable, QUEUE_SIZE>::set(
     return everything_shared;
 }
 
+template <class Serializable, int QUEUE_SIZE>
+bool Exchange_manager_producer<Serializable, QUEUE_SIZE>::set_batch(
+    const Serializable *serializables, std::size_t nb_items)
+{
+    bool everything_shared;
+
+    if (autolock_)
+    {
+        this->lock();
+    }
+
+    try
+    {
+        everything_shared = memory_->write_serialized(serializables, nb_items);
+    }
+    catch (const std::runtime_error &e)
+    {
+        if (autolock_)
+        {
+            this->unlock();
+        }
+        throw e;
+    }
+
+    if (autolock_)
+    {
+        this->unlock();
+    }
+
+    return everything_shared;
+}
+
+template <class Serializable, int QUEUE_SIZE>
+bool Exchange_manager_producer<Serializable, QUEUE_SIZE>::set_batch(
+    const std::vector<Serializable> &serializables)
+{
+    return set_batch(serializables.data(), serializables.size());
+}
+
 template <class Serializable, int QUEUE_SIZE>
 void Exchange_manager_producer<Serializable, QUEUE_SIZE>::get(
     std::deque<int> &get_consumed_ids)
@@ -151,6 +190,13 @@ void Exchange_manager_producer<Serializable, QUEUE_SIZE>::get(
     return;
 }
 
+template <class Serializable, int QUEUE_SIZE>
+bool Exchange_manager_producer<Serializable, QUEUE_SIZE>::wait_for_feedback(
+    long timeout_nano_seconds)
+{
+    return memory_->wait_for_feedback(timeout_nano_seconds);
+}
+
 template <class Serializable, int QUEUE_SIZE>
 void Exchange_manager_producer<Serializable, QUEUE_SIZE>::reset_char_count()
 {
@@ -0,0 +1,117 @@
+// Copyright (c) 2019 Max Planck Gesellschaft
+// Author : Vincent Berenz
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// This is non public support code for shared_memory::array
+
+namespace shared_memory
+{
+namespace internal
+{
+/**
+ * @brief size of the slots of arrays constructed with padded slots
+ * (or multiple of)
+ */
+static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+/**
+ * @brief first cache line boundary of memory, which should be allocated
+ * with one more cache line than required. Segments are mapped at page
+ * boundaries, so the returned address has the same offset from the
+ * beginning of the segment in all processes.
+ */
+inline char* align_to_cache_line(char* memory)
+{
+    std::size_t misalignment =
+        reinterpret_cast<std::uintptr_t>(memory) % CACHE_LINE_SIZE;
+    if (misalignment == 0)
+    {
+        return memory;
+    }
+    return memory + CACHE_LINE_SIZE - misalignment;
+}
+
+/**
+ * @brief Layout of the items of an array, stored in the segment of the
+ * array by the instance creating it, so that all instances pointing to
+ * the segment agree on it.
+ */
+struct ArrayLayout
+{
+    ArrayLayout(std::size_t slot_size_,
+                bool padded_slots_,
+                bool sequences_,
+                bool track_changes_)
+        : slot_size(slot_size_),
+          padded_slots(padded_slots_),
+          sequences(sequences_),
+          track_changes(track_changes_)
+    {
+    }
+
+    /**
+     * @brief number of bytes between the beginnings of two consecutive
+     * items
+     */
+    std::size_t slot_size;
+    /**
+     * @brief true if the items and their update stamps (if any) are each
+     * stored in their own cache line(s)
+     */
+    bool padded_slots;
+    /**
+     * @brief true if the items are protected by sequence counters
+     * (ARRAY_SINGLE_WRITER). Unlike the other members, instances attaching
+     * to the segment can not adopt it: the segment is sized for the
+     * objects of its creator.
+     */
+    bool sequences;
+    /**
+     * @brief true if the writes are counted in generations and update
+     * stamps stored in the segment
+     */
+    bool track_changes;
+};
+
+/**
+ * @brief Layout of a static_array, stored in its segment by the instance
+ * creating it. Instances attaching to the segment check it matches their
+ * compile time layout.
+ */
+struct StaticArrayLayout
+{
+    StaticArrayLayout(std::size_t capacity_,
+                      std::size_t item_size_,
+                      std::size_t item_alignment_,
+                      int sync_)
+        : capacity(capacity_),
+          item_size(item_size_),
+          item_alignment(item_alignment_),
+          sync(sync_)
+    {
+    }
+
+    bool operator==(const StaticArrayLayout& other) const
+    {
+        return capacity == other.capacity && item_size == other.item_size &&
+               item_alignment == other.item_alignment && sync == other.sync;
+    }
+
+    std::size_t capacity;
+    std::size_t item_size;
+    std::size_t item_alignment;
+    /**
+     * @brief one of the values of shared_memory::ArraySync (instances
+     * with different synchronizations do not construct the same objects
+     * in the segment)
+     */
+    int sync;
+};
+
+}  // namespace internal
+
+}  // namespace shared_memory
@@ -0,0 +1,55 @@
+// Copyright (c) 2019 Max Planck Gesellschaft
+// Author : Vincent Berenz
+
+#pragma once
+
+#include <string>
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
+
+// This is non public support code for shared_memory::array
+
+namespace shared_memory
+{
+namespace internal
+{
+/**
+ * @brief Mapping of the segment of an array into the process, and mutex
+ * of the array. Shared by an array and its copies, so that copying or
+ * moving an array does not open the segment (or the mutex) again.
+ */
+struct ArrayMapping
+{
+    ArrayMapping(const std::string& segment_id_, bool clear_on_destruction_)
+        : segment_id(segment_id_),
+          clear_on_destruction(clear_on_destruction_),
+          huge_pages(false),
+          mutex(boost::interprocess::open_or_create,
+                (segment_id_ + std::string("_mutex")).c_str())
+    {
+    }
+
+    /**
+     * @brief wipes the segment and the mutex if clear_on_destruction is
+     * true (read at destruction, i.e. once the last array sharing this
+     * mapping is destroyed, or when the construction of an array failed)
+     */
+    ~ArrayMapping();
+
+    ArrayMapping(const ArrayMapping&) = delete;
+    ArrayMapping& operator=(const ArrayMapping&) = delete;
+
+    std::string segment_id;
+    bool clear_on_destruction;
+    // true if the kernel accepted to back the mapping with huge pages
+    bool huge_pages;
+    boost::interprocess::managed_shared_memory segment;
+    // not a shared_memory::Mutex, whose destructor unlocks the mutex
+    // (and removes it if requested at construction)
+    boost::interprocess::named_mutex mutex;
+};
+
+}  // namespace internal
+
+}  // namespace shared_memory
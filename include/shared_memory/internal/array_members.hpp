@@ -3,6 +3,10 @@
 
 #pragma once
 
+#include <type_traits>
+
+#include "shared_memory/internal/seqlock.hpp"
+
 // This is non public support code for shared_memory::array
 
 namespace shared_memory
@@ -10,6 +14,7 @@ namespace shared_memory
 typedef std::integral_constant<int, 0> SERIALIZABLE;
 typedef std::integral_constant<int, 1> FUNDAMENTAL;
 typedef std::integral_constant<int, 2> FUNDAMENTAL_ARRAY;
+typedef std::integral_constant<int, 3> TRIVIALLY_COPYABLE;
 
 namespace internal
 {
@@ -23,6 +28,10 @@ protected:
     char* shared_;
     std::size_t item_size_;
     std::size_t total_size_;
+    // serialized items of set_range and get_range
+    std::string range_;
+    // one per item, nullptr unless ARRAY_SINGLE_WRITER
+    Sequence* sequences_;
     SERIALIZABLE type_;
 };
 
@@ -36,6 +45,8 @@ class array_members<
 {
 protected:
     T* shared_;
+    // one per item, nullptr unless ARRAY_SINGLE_WRITER
+    Sequence* sequences_;
     FUNDAMENTAL type_;
 };
 
@@ -50,9 +61,27 @@ class array_members<
 protected:
     T* shared_;
     std::size_t total_size_;
+    // one per item (of SIZE values), nullptr unless ARRAY_SINGLE_WRITER
+    Sequence* sequences_;
     FUNDAMENTAL_ARRAY type_;
 };
 
+// defining members for trivially copyable types (other than fundamental
+// types), which will directly be stored and copied with memcpy
+template <typename T>
+class array_members<
+    T,
+    0,
+    typename std::enable_if<!std::is_fundamental<T>::value &&
+                            std::is_trivially_copyable<T>::value>::type>
+{
+protected:
+    T* shared_;
+    // one per item, nullptr unless ARRAY_SINGLE_WRITER
+    Sequence* sequences_;
+    TRIVIALLY_COPYABLE type_;
+};
+
 }  // namespace internal
 
 }  // namespace shared_memory
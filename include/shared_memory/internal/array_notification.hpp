@@ -0,0 +1,172 @@
+// Copyright (c) 2019 Max Planck Gesellschaft
+// Author : Vincent Berenz
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/interprocess/sync/interprocess_condition.hpp>
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+
+#include "shared_memory/internal/array_layout.hpp"
+
+// This is non public support code for shared_memory::array
+// and the exchange manager
+
+namespace shared_memory
+{
+namespace internal
+{
+/**
+ * @brief number of writes to an element (or to all elements) of an array
+ */
+typedef std::atomic<std::uint64_t> Generation;
+
+/**
+ * @brief Generation and update stamp of an element of an array. Stored
+ * in zeroed memory of the segment (lock free atomics, for which zeroed
+ * memory holds the value 0).
+ */
+struct ElementStamps
+{
+    /**
+     * @brief number of writes to the element
+     */
+    Generation generation;
+    /**
+     * @brief generation of the array at the last write of the element
+     */
+    Generation updated_at;
+};
+
+static_assert(Generation::is_always_lock_free,
+              "generations are stored in zeroed shared memory");
+
+/**
+ * @brief number of elements of an array sharing an update stamp
+ * (see shared_memory::array::get_changed_since)
+ */
+static constexpr std::size_t ARRAY_BLOCK_SIZE = 64;
+
+/**
+ * @brief Stored in a segment, for waking up the processes (or threads)
+ * waiting for a generation stored in the same segment to change
+ * (see wait_for_generation and notify_waiters)
+ */
+struct Notification
+{
+    Notification() : waiters(0)
+    {
+    }
+
+    /**
+     * @brief number of processes (or threads) waiting: notifiers lock the
+     * mutex and notify the condition only if not 0
+     */
+    std::atomic<std::uint32_t> waiters;
+
+    boost::interprocess::interprocess_mutex mutex;
+    boost::interprocess::interprocess_condition condition;
+};
+
+/**
+ * @brief Stored in the segment of an array, for waking up the
+ * processes waiting for elements of the array to be written.
+ */
+struct ArrayNotification : public Notification
+{
+    ArrayNotification() : generation(0)
+    {
+    }
+
+    // the generation is written by each write to the array: kept off the
+    // cache lines of the members above (read by the writers) and of the
+    // objects constructed after it in the segment
+    char padding_begin[CACHE_LINE_SIZE];
+
+    /**
+     * @brief number of writes to the array
+     */
+    Generation generation;
+
+    char padding_end[CACHE_LINE_SIZE - sizeof(Generation)];
+};
+
+/**
+ * @brief sets stamp to value, unless stamp is already larger (lock free)
+ */
+inline void store_max(Generation& stamp, std::uint64_t value)
+{
+    std::uint64_t current = stamp.load(std::memory_order_relaxed);
+    while (current < value &&
+           !stamp.compare_exchange_weak(current,
+                                        value,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed))
+    {
+    }
+}
+
+/**
+ * @brief wait until generation differs from last_seen, or until the
+ * timeout expires (no timeout if timeout_nano_seconds is negative).
+ * @return false if the timeout expired
+ */
+inline bool wait_for_generation(Notification& notification,
+                               const Generation& generation,
+                               std::uint64_t last_seen,
+                               long timeout_nano_seconds)
+{
+    if (generation.load() != last_seen)
+    {
+        return true;
+    }
+    boost::posix_time::ptime deadline =
+        boost::posix_time::microsec_clock::universal_time() +
+        boost::posix_time::microseconds(timeout_nano_seconds / 1000);
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>
+        lock(notification.mutex);
+    notification.waiters.fetch_add(1);
+    bool updated = true;
+    while (generation.load() == last_seen)
+    {
+        if (timeout_nano_seconds < 0)
+        {
+            notification.condition.wait(lock);
+        }
+        else if (!notification.condition.timed_wait(lock, deadline))
+        {
+            updated = generation.load() != last_seen;
+            break;
+        }
+    }
+    notification.waiters.fetch_sub(1);
+    return updated;
+}
+
+/**
+ * @brief wakes up the waiters of notification, if any. To be called
+ * after (sequentially consistent) updates of the generation they wait on:
+ * waiters increase waiters before checking the generation (also
+ * sequentially consistent), so either they see the update, or they are
+ * seen here
+ */
+inline void notify_waiters(Notification& notification)
+{
+    if (notification.waiters.load() == 0)
+    {
+        return;
+    }
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>
+        lock(notification.mutex);
+    notification.condition.notify_all();
+}
+
+}  // namespace internal
+
+}  // namespace shared_memory
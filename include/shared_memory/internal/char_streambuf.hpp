@@ -0,0 +1,57 @@
+// Copyright (c) 2019 Max Planck Gesellschaft
+// Author : Vincent Berenz
+
+#pragma once
+
+#include <cstddef>
+#include <streambuf>
+
+// This is non public support code for reading and writing serialized
+// instances without copying them from or to the buffer of a
+// std::stringstream
+
+namespace shared_memory
+{
+namespace internal
+{
+/**
+ * @brief read only stream buffer over existing chars
+ * (which must outlive the buffer)
+ */
+class CharStreambuf : public std::streambuf
+{
+public:
+    CharStreambuf(const char* data, std::size_t size)
+    {
+        // std::streambuf requires non const pointers, but
+        // the get area is never written
+        char* begin = const_cast<char*>(data);
+        setg(begin, begin, begin + size);
+    }
+};
+
+/**
+ * @brief write only stream buffer over existing chars (which must outlive
+ * the buffer). Writing past the size chars fails (cereal archives writing
+ * to the buffer then throw a cereal::Exception).
+ */
+class CharOutStreambuf : public std::streambuf
+{
+public:
+    CharOutStreambuf(char* data, std::size_t size)
+    {
+        setp(data, data + size);
+    }
+
+    /**
+     * @brief number of chars written
+     */
+    std::size_t size() const
+    {
+        return pptr() - pbase();
+    }
+};
+
+}  // namespace internal
+
+}  // namespace shared_memory
@@ -0,0 +1,57 @@
+// Copyright (c) 2019 Max Planck Gesellschaft
+// Author : Vincent Berenz
+
+#pragma once
+
+#include <cstring>
+#include <type_traits>
+
+// This is non public support code for copying objects from and to
+// the shared memory
+
+namespace shared_memory
+{
+namespace internal
+{
+// items of trivially copyable types are copied in bulk
+// (memcpy uses vector instructions, and non temporal stores
+// for large sizes)
+template <typename ElemType>
+void copy(ElemType* destination,
+          const ElemType* source,
+          std::size_t size,
+          std::true_type)
+{
+    std::memcpy(static_cast<void*>(destination),
+                static_cast<const void*>(source),
+                size * sizeof(ElemType));
+}
+
+// other items are copied one by one
+template <typename ElemType>
+void copy(ElemType* destination,
+          const ElemType* source,
+          std::size_t size,
+          std::false_type)
+{
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        destination[i] = source[i];
+    }
+}
+
+/**
+ * @brief copies size items from source to destination
+ */
+template <typename ElemType>
+void copy(ElemType* destination, const ElemType* source, std::size_t size)
+{
+    copy(destination,
+         source,
+         size,
+         typename std::is_trivially_copyable<ElemType>::type());
+}
+
+}  // namespace internal
+
+}  // namespace shared_memory
@@ -0,0 +1,172 @@
+/**
+ * @file exchange_manager_broadcast_memory.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2019, New York University and Max Planck
+ * Gesellschaft.
+ *
+ * @brief Interprocess broadcast of serialized items to several consumers
+ */
+
+#pragma once
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "shared_memory/internal/array_notification.hpp"
+#include "shared_memory/internal/exchange_manager_memory.hpp"
+#include "shared_memory/internal/ring_buffer_indexes.hpp"
+#include "shared_memory/mutex.hpp"
+#include "shared_memory/serializer.hpp"
+
+namespace shared_memory
+{
+namespace internal
+{
+/* @brief Stored in the segment of a broadcast exchange manager: position
+ * after the records written by the producer, and counter of the
+ * consumers attached so far.
+ */
+struct BroadcastHead
+{
+    BroadcastHead() : head(0), sessions(0)
+    {
+    }
+
+    RingBufferIndexes::Index head;
+    char head_padding[RingBufferIndexes::cache_line -
+                      sizeof(RingBufferIndexes::Index)];
+
+    // incremented (under the mutex) each time a consumer attaches
+    std::uint64_t sessions;
+};
+
+/* @brief Stored in the segment of a broadcast exchange manager, one per
+ * consumer (each on its own cache line).
+ */
+struct BroadcastCursor
+{
+    BroadcastCursor() : tail(0), session(0)
+    {
+    }
+
+    // position of the oldest record not read yet by the consumer
+    RingBufferIndexes::Index tail;
+    // session of the attached consumer, 0 if no consumer is attached
+    // (or if the consumer has been dropped by the producer)
+    std::atomic<std::uint64_t> session;
+    char padding[RingBufferIndexes::cache_line -
+                 sizeof(RingBufferIndexes::Index) -
+                 sizeof(std::atomic<std::uint64_t>)];
+};
+
+/* @brief Used internally by Exchange_manager_broadcast_producer
+ * and Exchange_manager_broadcast_consumer. Do not use directly.
+ * Ring of records of serializable_size_ chars (one per serialized item)
+ * stored in the segment, of QUEUE_SIZE chars overall, read by up to
+ * NB_CONSUMERS consumers. Each consumer has its own position in the ring
+ * and its own queue for the feedback of the consumed ids. The producer
+ * writes a record only once all the attached consumers read the record
+ * it replaces.
+ */
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+class Exchange_manager_broadcast_memory
+{
+    typedef boost::lockfree::spsc_queue<int,
+                                        boost::lockfree::capacity<QUEUE_SIZE> >
+        feedback_queue;
+
+public:
+    Exchange_manager_broadcast_memory(std::string segment_id,
+                                      std::string object_id);
+
+    // producer side
+
+    // records the items, dropping the consumers preventing it if
+    // drop_slow_consumers is true. Returns false if some items could not
+    // be recorded (they are buffered and recorded at the next call)
+    bool write_serialized(const Serializable *serializables,
+                          std::size_t nb_items,
+                          bool drop_slow_consumers);
+    void get_consumed_ids(int consumer, std::deque<int> &get_ids);
+    // attached consumers which did not read lag items or more
+    void get_slow_consumers(std::size_t lag, std::vector<int> &slow_consumers);
+    void drop_consumer(int consumer);
+    std::size_t nb_consumers() const;
+
+    // consumer side
+
+    // throws a std::runtime_error if consumer is not a valid index or
+    // if another consumer is attached with this index
+    void attach(int consumer);
+    void detach();
+    // false once dropped by the producer
+    bool attached() const;
+    // reads up to max_items items, returns the number of items read
+    std::size_t read_serialized(Serializable *serializables,
+                                std::size_t max_items);
+    void write_serialized_ids(const std::vector<int> &ids);
+    bool purge_feedbacks();
+    bool wait_for_items(long timeout_nano_seconds);
+
+    void lock();
+    void unlock();
+
+    // number of records of the ring
+    std::size_t capacity() const;
+
+public:
+    static void clean_mutex(std::string segment_id);
+    static void clean_memory(std::string segment_id);
+
+private:
+    // address of the record at position (wrapping around the ring)
+    char *record(std::uint64_t position) const;
+    // position of the oldest record not read by all attached consumers
+    std::uint64_t oldest_tail(std::uint64_t head) const;
+    // true if the record at head can be written, i.e. if the attached
+    // consumers read the record it replaces (updating oldest, and dropping
+    // the consumers which did not if drop_slow_consumers is true)
+    bool has_room(std::uint64_t head,
+                  std::uint64_t &oldest,
+                  bool drop_slow_consumers);
+    // makes the records written from previous_head to head
+    // available to the consumers
+    void publish(std::uint64_t head, std::uint64_t previous_head);
+    void drop(int consumer);
+
+private:
+    std::string segment_id_;
+    bip::managed_shared_memory segment_;
+    shared_memory::Mutex locker_;
+    int serializable_size_;
+    // number of records of the ring
+    std::size_t capacity_;
+    char *records_;
+    BroadcastHead *head_;
+    BroadcastCursor *cursors_;
+    feedback_queue *feedbacks_;
+    Notification *notification_;
+    Serializer<Serializable> serializer_;
+    Serialized_write<Serializable> serialized_write_;
+
+    // consumer side: index and session of the consumer (-1 and 0 if
+    // not attached), records read by read_serialized, and ids which
+    // could not be pushed in the feedback queue (full)
+    int consumer_;
+    std::uint64_t session_;
+    std::vector<char> values_;
+    std::deque<int> consumed_buffer_;
+};
+
+#include "exchange_manager_broadcast_memory.hxx"
+
+}  // namespace internal
+}  // namespace shared_memory
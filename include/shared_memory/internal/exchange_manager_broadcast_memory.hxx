@@ -0,0 +1,411 @@
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    Exchange_manager_broadcast_memory(std::string segment_id,
+                                      std::string object_id)
+    : segment_id_(segment_id),
+      segment_(bip::open_or_create, segment_id.c_str(), 100 * 65536),
+      locker_(segment_id + "_locker", false),
+      serializable_size_(Serializer<Serializable>::serializable_size()),
+      consumer_(-1),
+      session_(0)
+{
+    // QUEUE_SIZE chars of records
+    capacity_ = std::max(QUEUE_SIZE / serializable_size_, 1);
+    records_ = segment_.find_or_construct<char>(
+        (object_id + "_broadcast").c_str())[capacity_ * serializable_size_](0);
+    head_ = segment_.find_or_construct<BroadcastHead>(
+        (object_id + "_broadcast_head").c_str())();
+    cursors_ = segment_.find_or_construct<BroadcastCursor>(
+        (object_id + "_broadcast_cursors").c_str())[NB_CONSUMERS]();
+    feedbacks_ = segment_.find_or_construct<feedback_queue>(
+        (object_id + "_broadcast_feedbacks").c_str())[NB_CONSUMERS]();
+    notification_ = segment_.find_or_construct<Notification>(
+        (object_id + "_broadcast_notification").c_str())();
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+char *
+Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    record(std::uint64_t position) const
+{
+    return records_ + (position % capacity_) * serializable_size_;
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+std::size_t
+Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    capacity() const
+{
+    return capacity_;
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+std::uint64_t
+Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    oldest_tail(std::uint64_t head) const
+{
+    // consumers attach under the mutex (locked by the producer),
+    // and only move their tail forward
+    std::uint64_t oldest = head;
+    for (int consumer = 0; consumer < NB_CONSUMERS; consumer++)
+    {
+        if (cursors_[consumer].session.load() != 0)
+        {
+            oldest = std::min(
+                oldest,
+                cursors_[consumer].tail.load(std::memory_order_acquire));
+        }
+    }
+    return oldest;
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    drop(int consumer)
+{
+    cursors_[consumer].session.store(0);
+    // the records are written after the consumer sees it is dropped
+    // (see read_serialized)
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+bool Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    has_room(std::uint64_t head,
+             std::uint64_t &oldest,
+             bool drop_slow_consumers)
+{
+    if (head - oldest < capacity_)
+    {
+        return true;
+    }
+    oldest = oldest_tail(head);
+    if (head - oldest < capacity_)
+    {
+        return true;
+    }
+    if (!drop_slow_consumers)
+    {
+        return false;
+    }
+    for (int consumer = 0; consumer < NB_CONSUMERS; consumer++)
+    {
+        if (cursors_[consumer].session.load() != 0 &&
+            head - cursors_[consumer].tail.load() >= capacity_)
+        {
+            drop(consumer);
+        }
+    }
+    oldest = oldest_tail(head);
+    return true;
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+bool Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    write_serialized(const Serializable *serializables,
+                     std::size_t nb_items,
+                     bool drop_slow_consumers)
+{
+    // only the producer moves the head, which is published once
+    // all the records that fit are written
+    std::uint64_t head = head_->head.load(std::memory_order_relaxed);
+    std::uint64_t previous_head = head;
+    std::uint64_t oldest = oldest_tail(head);
+
+    try
+    {
+        // items buffered by previous calls first
+        while (!serialized_write_.empty() &&
+               has_room(head, oldest, drop_slow_consumers))
+        {
+            serialized_write_.pop(record(head));
+            head++;
+        }
+        for (std::size_t i = 0; i < nb_items; i++)
+        {
+            if (serialized_write_.empty() &&
+                has_room(head, oldest, drop_slow_consumers))
+            {
+                // serialized directly in the record
+                serialized_write_.write(
+                    serializables[i], record(head), serializable_size_);
+                head++;
+            }
+            else
+            {
+                // a consumer is late, the remaining items are buffered
+                serialized_write_.write(serializables[i], serializable_size_);
+            }
+        }
+    }
+    catch (const std::runtime_error &e)
+    {
+        publish(head, previous_head);
+        throw;
+    }
+    publish(head, previous_head);
+
+    return serialized_write_.empty();
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    publish(std::uint64_t head, std::uint64_t previous_head)
+{
+    if (head == previous_head)
+    {
+        return;
+    }
+    // sequentially consistent, see notify_waiters
+    head_->head.store(head);
+    notify_waiters(*notification_);
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    get_consumed_ids(int consumer, std::deque<int> &get_ids)
+{
+    if (consumer < 0 || consumer >= NB_CONSUMERS)
+    {
+        throw std::runtime_error("invalid index");
+    }
+    int id;
+    while (feedbacks_[consumer].pop(id))
+    {
+        get_ids.push_back(id);
+    }
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    get_slow_consumers(std::size_t lag, std::vector<int> &slow_consumers)
+{
+    std::uint64_t head = head_->head.load(std::memory_order_relaxed);
+    for (int consumer = 0; consumer < NB_CONSUMERS; consumer++)
+    {
+        if (cursors_[consumer].session.load() != 0 &&
+            head - cursors_[consumer].tail.load() >= lag)
+        {
+            slow_consumers.push_back(consumer);
+        }
+    }
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    drop_consumer(int consumer)
+{
+    if (consumer < 0 || consumer >= NB_CONSUMERS)
+    {
+        throw std::runtime_error("invalid index");
+    }
+    drop(consumer);
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+std::size_t
+Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    nb_consumers() const
+{
+    std::size_t nb = 0;
+    for (int consumer = 0; consumer < NB_CONSUMERS; consumer++)
+    {
+        if (cursors_[consumer].session.load() != 0)
+        {
+            nb++;
+        }
+    }
+    return nb;
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    attach(int consumer)
+{
+    if (consumer < 0 || consumer >= NB_CONSUMERS)
+    {
+        throw std::runtime_error("invalid index");
+    }
+    lock();
+    if (cursors_[consumer].session.load() != 0)
+    {
+        unlock();
+        throw std::runtime_error(
+            "exchange manager broadcast: a consumer is already attached "
+            "with index " +
+            std::to_string(consumer));
+    }
+    // reading the items set from now on, the ids consumed by a
+    // previous consumer with this index are discarded
+    cursors_[consumer].tail.store(head_->head.load());
+    int id;
+    while (feedbacks_[consumer].pop(id))
+    {
+    }
+    consumed_buffer_.clear();
+    head_->sessions++;
+    session_ = head_->sessions;
+    consumer_ = consumer;
+    cursors_[consumer].session.store(session_);
+    unlock();
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    detach()
+{
+    if (consumer_ < 0)
+    {
+        return;
+    }
+    lock();
+    // if dropped, the index may be used by another consumer
+    std::uint64_t session = session_;
+    cursors_[consumer_].session.compare_exchange_strong(session, 0);
+    unlock();
+    consumer_ = -1;
+    session_ = 0;
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+bool Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    attached() const
+{
+    return consumer_ >= 0 && cursors_[consumer_].session.load() == session_;
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+std::size_t
+Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    read_serialized(Serializable *serializables, std::size_t max_items)
+{
+    if (!attached())
+    {
+        return 0;
+    }
+    BroadcastCursor &cursor = cursors_[consumer_];
+    // only this consumer moves its tail
+    std::uint64_t tail = cursor.tail.load(std::memory_order_relaxed);
+    std::uint64_t head = head_->head.load(std::memory_order_acquire);
+    std::size_t nb_items =
+        std::min(static_cast<std::size_t>(head - tail), max_items);
+    if (nb_items == 0)
+    {
+        return 0;
+    }
+    values_.resize(nb_items * serializable_size_);
+    for (std::size_t i = 0; i < nb_items; i++)
+    {
+        std::memcpy(values_.data() + i * serializable_size_,
+                    record(tail + i),
+                    serializable_size_);
+    }
+    // the producer overwrites the records of a consumer only after
+    // dropping it: if dropped meanwhile, the records are discarded
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (!attached())
+    {
+        return 0;
+    }
+    // fails if dropped meanwhile and another consumer attached
+    // with the same index (setting the tail to the head)
+    if (!cursor.tail.compare_exchange_strong(
+            tail, tail + nb_items, std::memory_order_acq_rel))
+    {
+        return 0;
+    }
+    for (std::size_t i = 0; i < nb_items; i++)
+    {
+        serializer_.deserialize(values_.data() + i * serializable_size_,
+                                serializable_size_,
+                                serializables[i]);
+    }
+    return nb_items;
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+bool Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    purge_feedbacks()
+{
+    // once dropped, the index may be used by another consumer: the
+    // buffered ids are discarded
+    if (!attached())
+    {
+        consumed_buffer_.clear();
+        return true;
+    }
+    while (!consumed_buffer_.empty())
+    {
+        if (!feedbacks_[consumer_].push(consumed_buffer_.front()))
+        {
+            return false;
+        }
+        consumed_buffer_.pop_front();
+    }
+    return true;
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    write_serialized_ids(const std::vector<int> &ids)
+{
+    if (!attached())
+    {
+        return;
+    }
+    // once an id is buffered, the following ones are buffered as
+    // well, so that the ids remain in order
+    bool purged = purge_feedbacks();
+    for (int id : ids)
+    {
+        if (!purged || !feedbacks_[consumer_].push(id))
+        {
+            purged = false;
+            consumed_buffer_.push_back(id);
+        }
+    }
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+bool Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    wait_for_items(long timeout_nano_seconds)
+{
+    if (!attached())
+    {
+        return false;
+    }
+    return wait_for_generation(*notification_,
+                               head_->head,
+                               cursors_[consumer_].tail.load(),
+                               timeout_nano_seconds);
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    lock()
+{
+    locker_.lock();
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    unlock()
+{
+    locker_.unlock();
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    clean_mutex(std::string segment_id)
+{
+    // mutex destruction called in destructor
+    shared_memory::Mutex m(segment_id + "_locker", true);
+}
+
+template <class Serializable, int QUEUE_SIZE, int NB_CONSUMERS>
+void Exchange_manager_broadcast_memory<Serializable, QUEUE_SIZE, NB_CONSUMERS>::
+    clean_memory(std::string segment_id)
+{
+    shared_memory::clear_shared_memory(segment_id);
+    shared_memory::delete_segment(segment_id);
+}
@@ -15,10 +15,16 @@
 #include <boost/interprocess/containers/string.hpp>
 #include <boost/interprocess/managed_shared_memory.hpp>
 #include <boost/lockfree/queue.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <string>
+#include <vector>
 #include <deque> 
 
+#include "shared_memory/internal/array_notification.hpp"
+#include "shared_memory/internal/ring_buffer_indexes.hpp"
 #include "shared_memory/mutex.hpp"
 #include "shared_memory/serializer.hpp"
 #include "shared_memory/shared_memory.hpp"
@@ -29,57 +35,63 @@ namespace shared_memory
 {
 namespace internal
 {
-template <class Serializable>
-class Serialized_read
-{
-public:
-    Serialized_read();
-    ~Serialized_read();
-    void set(char value);
-    bool read(Serializable &serializable);
-    int nb_char_read();
-    void reset_nb_char_read();
-
-private:
-    std::deque<char> buffer_;
-    int size_;
-    int nb_char_read_;
-    int serializable_size_;
-    char *values_;
-    Serializer<Serializable> serializer_;
-};
-
 template <class Serializable>
 class Serialized_write
 {
 public:
     Serialized_write();
-    ~Serialized_write();
     bool empty();
-    char front();
-    void pop();
+    // copies the oldest serialized item (of serializable_size_ chars)
+    // into record, and removes it
+    void pop(char *record);
+    // serializes the item after the items not popped yet
     void write(const Serializable &serializable, std::size_t expected_size);
+    // serializes the item directly into record (of expected_size chars)
+    void write(const Serializable &serializable,
+               char *record,
+               std::size_t expected_size);
     int nb_char_written();
     void reset_nb_char_written();
 
 private:
-    std::deque<char> buffer_;
-    char *values_;
+    // serialized items not popped yet: from begin_ to the end
+    std::vector<char> buffer_;
+    std::size_t begin_;
     int nb_char_written_;
     int serializable_size_;
     Serializer<Serializable> serializer_;
 };
 
+/* @brief Stored in the segment of an exchange manager, for waking up a
+ * consumer waiting for items, or a producer waiting for the feedback
+ * of consumed items.
+ */
+struct ExchangeNotifications
+{
+    ExchangeNotifications() : feedbacks(0)
+    {
+    }
+
+    // notified by the producer when the queue is no longer empty
+    // (the consumer waits for the head of the queue to move)
+    Notification items;
+
+    // number of consumed ids written by the consumer
+    Generation feedbacks;
+    // notified by the consumer when writing consumed ids
+    Notification feedback;
+};
+
 /* @brief Used internally by Exchange_manager_consumer
  * and Exchange_manager_producer. Do not use directly.
+ * The producer queue is a single producer / single consumer ring of
+ * records of serializable_size_ chars (one per serialized item) stored in
+ * the segment, of QUEUE_SIZE chars overall: pushing or popping an item
+ * copies its record and updates one index.
  */
 template <class Serializable, int QUEUE_SIZE>
 class Exchange_manager_memory
 {
-    typedef boost::lockfree::queue<char,
-                                   boost::lockfree::fixed_sized<true>,
-                                   boost::lockfree::capacity<QUEUE_SIZE> >
-        producer_queue;
     typedef boost::lockfree::queue<int,
                                    boost::lockfree::fixed_sized<true>,
                                    boost::lockfree::capacity<QUEUE_SIZE> >
@@ -98,8 +110,14 @@ public:
     ~Exchange_manager_memory();
 
     bool read_serialized(Serializable &serializable);
+    // reads up to max_items items, returns the number of items read
+    std::size_t read_serialized(Serializable *serializables,
+                                std::size_t max_items);
     bool write_serialized(const Serializable &serializable);
+    bool write_serialized(const Serializable *serializables,
+                          std::size_t nb_items);
     void write_serialized_id(int id);
+    void write_serialized_ids(const std::vector<int> &ids);
     void clear();
     void get_consumed_ids(std::deque<int> &get_ids);
 
@@ -108,6 +126,14 @@ public:
 
     bool purge_feedbacks();
 
+    // wait until the producer queue is not empty (or the timeout expires,
+    // no timeout if negative). Returns false if the timeout expired
+    bool wait_for_items(long timeout_nano_seconds);
+    // wait until the consumer wrote ids not read yet by get_consumed_ids
+    // (or the timeout expires, no timeout if negative). Returns false if
+    // the timeout expired
+    bool wait_for_feedback(long timeout_nano_seconds);
+
     void clean();
 
     void lock();
@@ -118,6 +144,18 @@ public:
 
     void weird_purge();
 
+private:
+    // address of the record at position (wrapping around the ring)
+    char *record(std::uint64_t position) const;
+    // makes the records written from previous_head to head
+    // available to the consumer
+    void publish(std::uint64_t head, std::uint64_t previous_head);
+    // pushes the ids of consumed_buffer_ into consumed_ (counting them
+    // in nb_pushed), returns true if consumed_buffer_ is then empty
+    bool push_buffered_ids(std::size_t &nb_pushed);
+    // counts nb_pushed ids into the feedbacks, and wakes up the producer
+    void notify_feedbacks(std::size_t nb_pushed);
+
 public:
     // for monitoring the number of characters written/read
     // from the queue
@@ -139,14 +177,23 @@ public:
     std::string object_id_consumer_;
     std::string object_id_status_;
     bip::managed_shared_memory segment_;
-    producer_queue *produced_;
+    // records of the serialized items (producer queue), and positions
+    // of the producer (head) and of the consumer (tail) in the records
+    char *records_;
+    RingBufferIndexes *indexes_;
+    ExchangeNotifications *notifications_;
+    // feedbacks counted when get_consumed_ids was last called
+    std::uint64_t feedbacks_seen_;
     std::deque<int> consumed_buffer_;
     consumer_queue *consumed_;
-    char *values_;
+    // records read by read_serialized
+    std::vector<char> values_;
     shared_memory::Mutex locker_;
-    Serialized_read<Serializable> serialized_read_;
+    Serializer<Serializable> serializer_;
     Serialized_write<Serializable> serialized_write_;
     int serializable_size_;
+    // number of records of the producer queue
+    std::size_t capacity_;
 };
 
 #include "exchange_manager_memory.hxx"
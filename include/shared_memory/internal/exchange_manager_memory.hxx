@@ -1,70 +1,9 @@
-
-
-template <class Serializable>
-Serialized_read<Serializable>::Serialized_read()
-    : size_(0),
-      nb_char_read_(0),
-      serializable_size_(Serializer<Serializable>::serializable_size())
-{
-    values_ = new char[serializable_size_];
-}
-
-template <class Serializable>
-Serialized_read<Serializable>::~Serialized_read()
-{
-    delete[] values_;
-}
-
-template <class Serializable>
-void Serialized_read<Serializable>::set(char value)
-{
-    size_++;
-    buffer_.push_back(value);
-}
-
-template <class Serializable>
-bool Serialized_read<Serializable>::read(Serializable &serializable)
-{
-    if (size_ >= serializable_size_)
-    {
-        for (int i = 0; i < serializable_size_; i++)
-        {
-            values_[i] = buffer_.front();
-            buffer_.pop_front();
-            size_--;
-            nb_char_read_++;
-        }
-        serializer_.deserialize(std::string(values_, serializable_size_),
-                                serializable);
-        return true;
-    }
-    return false;
-}
-
-template <class Serializable>
-void Serialized_read<Serializable>::reset_nb_char_read()
-{
-    nb_char_read_ = 0;
-}
-
-template <class Serializable>
-int Serialized_read<Serializable>::nb_char_read()
-{
-    return nb_char_read_;
-}
-
 template <class Serializable>
 Serialized_write<Serializable>::Serialized_write()
-    : nb_char_written_(0),
+    : begin_(0),
+      nb_char_written_(0),
       serializable_size_(Serializer<Serializable>::serializable_size())
 {
-    values_ = new char[serializable_size_];
-}
-
-template <class Serializable>
-Serialized_write<Serializable>::~Serialized_write()
-{
-    delete[] values_;
 }
 
 template <class Serializable>
@@ -82,37 +21,69 @@ void Serialized_write<Serializable>::reset_nb_char_written()
 template <class Serializable>
 bool Serialized_write<Serializable>::empty()
 {
-    return buffer_.empty();
+    return begin_ == buffer_.size();
 }
 
 template <class Serializable>
-char Serialized_write<Serializable>::front()
+void Serialized_write<Serializable>::pop(char *record)
 {
-    char value = buffer_.front();
-    return value;
+    std::memcpy(record, buffer_.data() + begin_, serializable_size_);
+    begin_ += serializable_size_;
+    if (begin_ == buffer_.size())
+    {
+        // keeping the capacity of the buffer
+        buffer_.clear();
+        begin_ = 0;
+    }
+    else if (begin_ >= buffer_.size() - begin_)
+    {
+        // the buffer may not get empty if items are written as fast
+        // as they are popped: moving the items not popped yet (fewer
+        // than the popped ones) to the front
+        buffer_.erase(buffer_.begin(), buffer_.begin() + begin_);
+        begin_ = 0;
+    }
 }
 
 template <class Serializable>
-void Serialized_write<Serializable>::pop()
+void Serialized_write<Serializable>::write(const Serializable &serializable,
+                                           std::size_t expected_size)
 {
-    buffer_.pop_front();
+    std::size_t end = buffer_.size();
+    buffer_.resize(end + expected_size);
+    try
+    {
+        write(serializable, buffer_.data() + end, expected_size);
+    }
+    catch (const std::runtime_error &e)
+    {
+        buffer_.resize(end);
+        throw;
+    }
 }
 
 template <class Serializable>
 void Serialized_write<Serializable>::write(const Serializable &serializable,
+                                           char *record,
                                            std::size_t expected_size)
 {
-    const std::string &s = serializer_.serialize(serializable);
-    if (s.size() != expected_size)
+    bool expected = true;
+    try
     {
-        throw std::runtime_error(
-            "exchange_manager_memory: serialized string of unexpected size\n");
+        expected = serializer_.serialize(serializable, record, expected_size) ==
+                   expected_size;
     }
-    for (char c : s)
+    catch (const std::runtime_error &e)
     {
-        nb_char_written_++;
-        buffer_.push_back(c);
+        // larger than expected
+        expected = false;
     }
+    if (!expected)
+    {
+        throw std::runtime_error(
+            "exchange_manager_memory: serialized string of unexpected size\n");
+    }
+    nb_char_written_ += expected_size;
 }
 
 template <class Serializable, int QUEUE_SIZE>
@@ -122,24 +93,32 @@ Exchange_manager_memory<Serializable, QUEUE_SIZE>::Exchange_manager_memory(
     : nb_char_read_(0),
       nb_char_written_(0),
       segment_(bip::open_or_create, segment_id.c_str(), 100 * 65536),
+      feedbacks_seen_(0),
       locker_(std::string(segment_id + "_locker").c_str(), false),
       serializable_size_(Serializer<Serializable>::serializable_size())
 {
     object_id_producer_ = object_id + "_producer";
     object_id_consumer_ = object_id + "_consumer";
     object_id_status_ = object_id + "_status";
-    produced_ = segment_.find_or_construct<producer_queue>(
-        object_id_producer_.c_str())();
+
+    // QUEUE_SIZE chars of records
+    capacity_ = std::max(QUEUE_SIZE / serializable_size_, 1);
+    records_ = segment_.find_or_construct<char>(object_id_producer_.c_str())
+        [capacity_ * serializable_size_](0);
+    indexes_ = segment_.find_or_construct<RingBufferIndexes>(
+        (object_id_producer_ + "_indexes").c_str())();
+    notifications_ = segment_.find_or_construct<ExchangeNotifications>(
+        (object_id + "_notifications").c_str())();
+
     consumed_ = segment_.find_or_construct<consumer_queue>(
         object_id_consumer_.c_str())();
     segment_id_ = segment_id;
-    values_ = new char[serializable_size_];
 
-    // dev note: not sure what is happening, but the queues
-    // (produced_ and consumed_) are not defined empty, despite
-    // their empty() function returning true (i.e. items can
-    // be poped from them). This results to various undefined behavior.
-    // This function removes all these items from the queues.
+    // dev note: not sure what is happening, but the queue
+    // consumed_ is not defined empty, despite
+    // its empty() function returning true (i.e. items can
+    // be poped from it). This results to various undefined behavior.
+    // This function removes all these items from the queue.
     weird_purge();
 }
 
@@ -151,18 +130,8 @@ void Exchange_manager_memory<Serializable, QUEUE_SIZE>::weird_purge()
 {
     lock();
 
-    char foo;
     int foo_;
 
-    while (produced_->empty())
-    {
-        bool poped = produced_->pop(foo);
-        if (!poped)
-        {
-            break;
-        }
-    }
-
     while (consumed_->empty())
     {
         bool poped = consumed_->pop(foo_);
@@ -179,7 +148,6 @@ template <class Serializable, int QUEUE_SIZE>
 Exchange_manager_memory<Serializable, QUEUE_SIZE>::~Exchange_manager_memory()
 {
     unlock();
-    delete[] values_;
 }
 
 template <class Serializable, int QUEUE_SIZE>
@@ -240,37 +208,68 @@ void Exchange_manager_memory<Serializable, QUEUE_SIZE>::clean_memory(
     shared_memory::delete_segment(segment_id);
 }
 
+template <class Serializable, int QUEUE_SIZE>
+char *Exchange_manager_memory<Serializable, QUEUE_SIZE>::record(
+    std::uint64_t position) const
+{
+    return records_ + (position % capacity_) * serializable_size_;
+}
+
 template <class Serializable, int QUEUE_SIZE>
 bool Exchange_manager_memory<Serializable, QUEUE_SIZE>::read_serialized(
     Serializable &serializable)
 {
-    while (!produced_->empty())
+    return read_serialized(&serializable, 1) == 1;
+}
+
+template <class Serializable, int QUEUE_SIZE>
+std::size_t Exchange_manager_memory<Serializable, QUEUE_SIZE>::read_serialized(
+    Serializable *serializables, std::size_t max_items)
+{
+    std::size_t nb_items;
+    std::uint64_t tail = indexes_->tail.load(std::memory_order_acquire);
+    while (true)
     {
-        char value;
-        bool poped = produced_->pop(value);
-        if (poped)
+        std::uint64_t head = indexes_->head.load(std::memory_order_acquire);
+        nb_items = std::min(static_cast<std::size_t>(head - tail), max_items);
+        if (nb_items == 0)
         {
-            nb_char_read_++;
-            serialized_read_.set(value);
+            return 0;
         }
-        else
+        values_.resize(nb_items * serializable_size_);
+        for (std::size_t i = 0; i < nb_items; i++)
+        {
+            std::memcpy(values_.data() + i * serializable_size_,
+                        record(tail + i),
+                        serializable_size_);
+        }
+        // the tail moves only forward: if the producer cleared the
+        // queue meanwhile, the records may have been overwritten
+        // and are discarded
+        if (indexes_->tail.compare_exchange_strong(
+                tail, tail + nb_items, std::memory_order_acq_rel))
         {
             break;
         }
     }
-
-    bool read = serialized_read_.read(serializable);
-
-    return read;
+    for (std::size_t i = 0; i < nb_items; i++)
+    {
+        serializer_.deserialize(values_.data() + i * serializable_size_,
+                                serializable_size_,
+                                serializables[i]);
+    }
+    nb_char_read_ += nb_items * serializable_size_;
+    return nb_items;
 }
 
 template <class Serializable, int QUEUE_SIZE>
 void Exchange_manager_memory<Serializable, QUEUE_SIZE>::clear()
 {
-    char foo;
-    while (!produced_->empty())
+    std::uint64_t tail = indexes_->tail.load(std::memory_order_acquire);
+    std::uint64_t head = indexes_->head.load(std::memory_order_acquire);
+    while (tail != head && !indexes_->tail.compare_exchange_weak(
+                               tail, head, std::memory_order_acq_rel))
     {
-        produced_->pop(foo);
     }
 }
 
@@ -278,32 +277,84 @@ template <class Serializable, int QUEUE_SIZE>
 bool Exchange_manager_memory<Serializable, QUEUE_SIZE>::write_serialized(
     const Serializable &serializable)
 {
-    bool everything_shared = true;
+    return write_serialized(&serializable, 1);
+}
 
-    serialized_write_.write(serializable, serializable_size_);
+template <class Serializable, int QUEUE_SIZE>
+bool Exchange_manager_memory<Serializable, QUEUE_SIZE>::write_serialized(
+    const Serializable *serializables, std::size_t nb_items)
+{
+    // only the producer moves the head, which is published once
+    // all the records that fit are written
+    std::uint64_t head = indexes_->head.load(std::memory_order_relaxed);
+    std::uint64_t previous_head = head;
+    std::uint64_t tail = indexes_->tail.load(std::memory_order_acquire);
+    auto has_room = [this, &head, &tail]() {
+        if (head - tail >= capacity_)
+        {
+            tail = indexes_->tail.load(std::memory_order_acquire);
+        }
+        return head - tail < capacity_;
+    };
 
-    while (!serialized_write_.empty())
+    try
     {
-        char value = serialized_write_.front();
-        bool pushed = produced_->bounded_push(value);
-
-        if (pushed)
+        // items buffered by previous calls first
+        while (!serialized_write_.empty() && has_room())
         {
-            nb_char_written_++;
-            serialized_write_.pop();
+            serialized_write_.pop(record(head));
+            head++;
+            nb_char_written_ += serializable_size_;
         }
-        else
+        for (std::size_t i = 0; i < nb_items; i++)
         {
-            everything_shared = false;
-            break;
+            if (serialized_write_.empty() && has_room())
+            {
+                // serialized directly in the record
+                serialized_write_.write(
+                    serializables[i], record(head), serializable_size_);
+                head++;
+                nb_char_written_ += serializable_size_;
+            }
+            else
+            {
+                // queue full, the remaining items are buffered
+                serialized_write_.write(serializables[i], serializable_size_);
+            }
         }
     }
+    catch (const std::runtime_error &e)
+    {
+        publish(head, previous_head);
+        throw;
+    }
+    publish(head, previous_head);
 
-    return everything_shared;
+    return serialized_write_.empty();
 }
 
 template <class Serializable, int QUEUE_SIZE>
-bool Exchange_manager_memory<Serializable, QUEUE_SIZE>::purge_feedbacks()
+void Exchange_manager_memory<Serializable, QUEUE_SIZE>::publish(
+    std::uint64_t head, std::uint64_t previous_head)
+{
+    if (head == previous_head)
+    {
+        return;
+    }
+    // sequentially consistent, see notify_waiters
+    indexes_->head.store(head);
+
+    // the consumer waits only on an empty queue (tail equal to
+    // the previous head)
+    if (indexes_->tail.load() == previous_head)
+    {
+        notify_waiters(notifications_->items);
+    }
+}
+
+template <class Serializable, int QUEUE_SIZE>
+bool Exchange_manager_memory<Serializable, QUEUE_SIZE>::push_buffered_ids(
+    std::size_t &nb_pushed)
 {
     while (!consumed_buffer_.empty())
     {
@@ -316,12 +367,35 @@ bool Exchange_manager_memory<Serializable, QUEUE_SIZE>::purge_feedbacks()
         else
         {
             consumed_buffer_.pop_front();
+            nb_pushed++;
         }
     }
 
     return true;
 }
 
+template <class Serializable, int QUEUE_SIZE>
+void Exchange_manager_memory<Serializable, QUEUE_SIZE>::notify_feedbacks(
+    std::size_t nb_pushed)
+{
+    if (nb_pushed == 0)
+    {
+        return;
+    }
+    // sequentially consistent, see notify_waiters
+    notifications_->feedbacks.fetch_add(nb_pushed);
+    notify_waiters(notifications_->feedback);
+}
+
+template <class Serializable, int QUEUE_SIZE>
+bool Exchange_manager_memory<Serializable, QUEUE_SIZE>::purge_feedbacks()
+{
+    std::size_t nb_pushed = 0;
+    bool purged = push_buffered_ids(nb_pushed);
+    notify_feedbacks(nb_pushed);
+    return purged;
+}
+
 template <class Serializable, int QUEUE_SIZE>
 void Exchange_manager_memory<Serializable, QUEUE_SIZE>::write_serialized_id(
     int id)
@@ -329,7 +403,8 @@ void Exchange_manager_memory<Serializable, QUEUE_SIZE>::write_serialized_id(
     // if some consumed id could previously not be set in the shared memory
     // (because this latest was full), they have been buffered
     // in consumed_buffer_. Trying to purge it.
-    purge_feedbacks();
+    std::size_t nb_pushed = 0;
+    push_buffered_ids(nb_pushed);
 
     // trying to push id that was read into consumed_,
     // to inform the producer that this item has been consumed
@@ -340,6 +415,36 @@ void Exchange_manager_memory<Serializable, QUEUE_SIZE>::write_serialized_id(
     {
         consumed_buffer_.push_back(id);
     }
+    else
+    {
+        nb_pushed++;
+    }
+
+    notify_feedbacks(nb_pushed);
+}
+
+template <class Serializable, int QUEUE_SIZE>
+void Exchange_manager_memory<Serializable, QUEUE_SIZE>::write_serialized_ids(
+    const std::vector<int> &ids)
+{
+    // see write_serialized_id. Once an id is buffered, the following
+    // ones are buffered as well, so that the ids remain in order
+    std::size_t nb_pushed = 0;
+    bool purged = push_buffered_ids(nb_pushed);
+    for (int id : ids)
+    {
+        if (purged && consumed_->push(id))
+        {
+            nb_pushed++;
+        }
+        else
+        {
+            purged = false;
+            consumed_buffer_.push_back(id);
+        }
+    }
+
+    notify_feedbacks(nb_pushed);
 }
 
 template <class Serializable, int QUEUE_SIZE>
@@ -347,7 +452,11 @@ void Exchange_manager_memory<Serializable, QUEUE_SIZE>::get_consumed_ids(
     std::deque<int> &get_consumed_ids)
 {
     int id;
-    bool has_consumed;
+    bool has_consumed = true;
+
+    // ids written after this are not popped below, or are popped
+    // and then reported again by wait_for_feedback (spuriously)
+    feedbacks_seen_ = notifications_->feedbacks.load();
 
     while (has_consumed)
     {
@@ -360,6 +469,27 @@ void Exchange_manager_memory<Serializable, QUEUE_SIZE>::get_consumed_ids(
     }
 }
 
+template <class Serializable, int QUEUE_SIZE>
+bool Exchange_manager_memory<Serializable, QUEUE_SIZE>::wait_for_items(
+    long timeout_nano_seconds)
+{
+    // only the consumer moves the tail (or the producer when
+    // clearing the queue, in which case this returns early)
+    std::uint64_t tail = indexes_->tail.load();
+    return wait_for_generation(
+        notifications_->items, indexes_->head, tail, timeout_nano_seconds);
+}
+
+template <class Serializable, int QUEUE_SIZE>
+bool Exchange_manager_memory<Serializable, QUEUE_SIZE>::wait_for_feedback(
+    long timeout_nano_seconds)
+{
+    return wait_for_generation(notifications_->feedback,
+                               notifications_->feedbacks,
+                               feedbacks_seen_,
+                               timeout_nano_seconds);
+}
+
 template <class Serializable, int QUEUE_SIZE>
 void Exchange_manager_memory<Serializable, QUEUE_SIZE>::reset_char_count()
 {
@@ -390,5 +520,6 @@ template <class Serializable, int QUEUE_SIZE>
 bool Exchange_manager_memory<Serializable, QUEUE_SIZE>::producer_queue_empty()
     const
 {
-    return produced_->empty();
+    return indexes_->tail.load(std::memory_order_acquire) ==
+           indexes_->head.load(std::memory_order_acquire);
 }
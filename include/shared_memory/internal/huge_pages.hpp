@@ -0,0 +1,48 @@
+// Copyright (c) 2019 Max Planck Gesellschaft
+// Author : Vincent Berenz
+
+#pragma once
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdint>
+
+#include <boost/interprocess/managed_shared_memory.hpp>
+
+// This is non public support code for backing segments with huge pages
+
+namespace shared_memory
+{
+namespace internal
+{
+/**
+ * @brief advises the kernel to back the memory of the segment with
+ * (transparent) huge pages. Only the memory faulted after this call
+ * is concerned. The advice is honored only if the tmpfs hosting the
+ * segments (/dev/shm) is mounted with huge pages enabled (mount option
+ * huge=advise).
+ * @return false if the kernel rejected the advice (e.g. kernel without
+ * transparent huge pages support), in which case the segment remains backed
+ * by regular pages
+ */
+inline bool advise_huge_pages(
+    boost::interprocess::managed_shared_memory& segment_manager)
+{
+#ifdef MADV_HUGEPAGE
+    // madvise requires an address aligned on pages, and the
+    // mapping starts at a page boundary before the segment address
+    std::uintptr_t page_size = static_cast<std::uintptr_t>(sysconf(_SC_PAGESIZE));
+    std::uintptr_t address =
+        reinterpret_cast<std::uintptr_t>(segment_manager.get_address());
+    std::uintptr_t start = address - address % page_size;
+    std::size_t size = segment_manager.get_size() + (address - start);
+    return madvise(reinterpret_cast<void*>(start), size, MADV_HUGEPAGE) == 0;
+#else
+    return false;
+#endif
+}
+
+}  // namespace internal
+
+}  // namespace shared_memory
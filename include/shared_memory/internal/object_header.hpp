@@ -0,0 +1,142 @@
+// Copyright (c) 2019 Max Planck Gesellschaft
+// Author : Vincent Berenz
+
+#pragma once
+
+#include <string>
+
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+
+#include "shared_memory/internal/copy.hpp"
+#include "shared_memory/internal/seqlock.hpp"
+#include "shared_memory/object_sync.hpp"
+
+// This is non public support code for shared_memory::SharedMemorySegment
+
+namespace shared_memory
+{
+namespace internal
+{
+/**
+ * @brief Synchronization data stored in the segment next to an object
+ * created with a policy other than SEGMENT_MUTEX (see
+ * shared_memory::ObjectSync). As it lives in the shared memory, all
+ * processes accessing the object agree on the policy.
+ */
+struct ObjectHeader
+{
+    explicit ObjectHeader(int sync_) : sync(sync_), sequence(0)
+    {
+    }
+
+    /**
+     * @brief one of the values of shared_memory::ObjectSync
+     */
+    int sync;
+
+    /**
+     * @brief SEQLOCK policy: incremented by writers before and after
+     * each write, i.e. odd while a write is in progress
+     */
+    Sequence sequence;
+
+    /**
+     * @brief locked by writers (and by readers for the OBJECT_MUTEX policy)
+     */
+    boost::interprocess::interprocess_mutex mutex;
+
+    /**
+     * @brief SEQLOCK policy: to be called by a writer (holding the mutex)
+     * before writing the object
+     */
+    void begin_write()
+    {
+        seqlock_begin_write(&sequence, 1);
+    }
+
+    /**
+     * @brief SEQLOCK policy: to be called by a writer (holding the mutex)
+     * after writing the object
+     */
+    void end_write()
+    {
+        seqlock_end_write(&sequence, 1);
+    }
+
+    /**
+     * @brief copies size items from source into the object (at destination)
+     * according to the policy
+     */
+    template <typename ElemType>
+    void write(ElemType* destination, const ElemType* source, std::size_t size);
+
+    /**
+     * @brief copies size items from the object (at source) to destination
+     * according to the policy
+     */
+    template <typename ElemType>
+    void read(const ElemType* source, ElemType* destination, std::size_t size);
+};
+
+/**
+ * @brief copies size items from source to destination without
+ * locking, repeating the copy until no write occurred meanwhile.
+ * @param header header of the object, with the SEQLOCK policy
+ * @param source address of the object in the shared memory
+ */
+template <typename ElemType>
+void seqlock_read(const ObjectHeader& header,
+                  const ElemType* source,
+                  ElemType* destination,
+                  std::size_t size)
+{
+    seqlock_read(&header.sequence, 1, [source, destination, size]() {
+        internal::copy(destination, source, size);
+    });
+}
+
+template <typename ElemType>
+void ObjectHeader::write(ElemType* destination,
+                         const ElemType* source,
+                         std::size_t size)
+{
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>
+        lock(mutex);
+    if (sync == SEQLOCK)
+    {
+        begin_write();
+        internal::copy(destination, source, size);
+        end_write();
+        return;
+    }
+    internal::copy(destination, source, size);
+}
+
+template <typename ElemType>
+void ObjectHeader::read(const ElemType* source,
+                        ElemType* destination,
+                        std::size_t size)
+{
+    if (sync == SEQLOCK)
+    {
+        seqlock_read(*this, source, destination, size);
+        return;
+    }
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>
+        lock(mutex);
+    internal::copy(destination, source, size);
+}
+
+/**
+ * @brief name under which the header of an object is stored
+ * in the segment
+ */
+inline std::string object_header_id(const std::string& object_id)
+{
+    return object_id + "_sync";
+}
+
+}  // namespace internal
+
+}  // namespace shared_memory
@@ -0,0 +1,53 @@
+// Copyright (c) 2019 Max Planck Gesellschaft
+// Author : Vincent Berenz
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// This is non public support code for shared_memory::ring_buffer
+
+namespace shared_memory
+{
+namespace internal
+{
+/**
+ * @brief positions (i.e. number of items pushed or popped since the
+ * creation of the buffer) shared by the producer and the consumers of a
+ * ring buffer. Each index is on its own cache line, so that the producer
+ * and the consumers do not invalidate each other's cache lines more than
+ * required.
+ */
+struct RingBufferIndexes
+{
+    RingBufferIndexes() : claimed(0), head(0), tail(0)
+    {
+    }
+
+    static constexpr std::size_t cache_line = 64;
+    typedef std::atomic<std::uint64_t> Index;
+
+    /**
+     * @brief position after the items the producer started to write
+     * (used only when overwriting the oldest items)
+     */
+    Index claimed;
+    char claimed_padding[cache_line - sizeof(Index)];
+
+    /**
+     * @brief position after the items the producer finished to write
+     */
+    Index head;
+    char head_padding[cache_line - sizeof(Index)];
+
+    /**
+     * @brief position of the oldest item not popped yet
+     */
+    Index tail;
+    char tail_padding[cache_line - sizeof(Index)];
+};
+
+}  // namespace internal
+
+}  // namespace shared_memory
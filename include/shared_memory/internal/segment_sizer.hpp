@@ -0,0 +1,85 @@
+// Copyright (c) 2019 Max Planck Gesellschaft
+// Author : Vincent Berenz
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// This is non public support code for sizing the segments of
+// shared_memory::array and shared_memory::static_array
+
+namespace shared_memory
+{
+namespace internal
+{
+/**
+ * @brief Computes the size of a shared memory segment required for
+ * constructing a set of named objects, including the overhead of the
+ * segment (header, index of the named objects), the padding due to
+ * the alignment of the objects and a safety margin.
+ */
+class SegmentSizer
+{
+public:
+    /**
+     * @brief bytes added to the computed size of segments. The dry run
+     * reproduces the allocations of a segment exactly, but would not
+     * absorb differences between the buffer it allocates in and a
+     * mapped segment (e.g. a bookkeeping change in another version of
+     * boost): they cost segments a few free bytes, rather than a
+     * boost::interprocess::bad_alloc at construction.
+     */
+    static constexpr std::size_t SAFETY_MARGIN = 256;
+
+    /**
+     * @brief bytes of a managed_shared_memory preceding the memory
+     * managed by its segment manager
+     */
+    static std::size_t get_header_size();
+
+    /**
+     * @brief declares an object of nb_items T to be constructed in the
+     * segment under this name. Objects should be declared in the order
+     * they are constructed.
+     */
+    template <typename T>
+    void add(const std::string& name, std::size_t nb_items = 1)
+    {
+        objects_.push_back(Object{name, nb_items * sizeof(T), alignof(T)});
+    }
+
+    /**
+     * @brief declares the objects declared to other (after the objects
+     * already declared)
+     */
+    void add(const SegmentSizer& other)
+    {
+        objects_.insert(
+            objects_.end(), other.objects_.begin(), other.objects_.end());
+    }
+
+    /**
+     * @brief minimal size of a segment in which all the declared objects
+     * can be constructed, plus SAFETY_MARGIN. Computed by allocating the objects in a buffer
+     * managed like a managed_shared_memory (same allocation algorithm and
+     * index), with at most two units of alignment of their items: the
+     * rest of the items is counted, but not allocated. Alignments must
+     * be powers of two (throws a std::logic_error otherwise).
+     */
+    std::size_t get_segment_size() const;
+
+private:
+    struct Object
+    {
+        std::string name;
+        std::size_t bytes;
+        std::size_t alignment;
+    };
+    std::vector<Object> objects_;
+};
+
+}  // namespace internal
+
+}  // namespace shared_memory
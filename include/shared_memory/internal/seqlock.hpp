@@ -0,0 +1,123 @@
+// Copyright (c) 2019 Max Planck Gesellschaft
+// Author : Vincent Berenz
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+
+// This is non public support code for reading data written
+// concurrently without locking (sequence locks)
+
+namespace shared_memory
+{
+namespace internal
+{
+/**
+ * @brief sequence counter, incremented by writers before and
+ * after each write, i.e. odd while a write is in progress
+ */
+typedef std::atomic<std::uint64_t> Sequence;
+
+/**
+ * @brief to be called by a writer before writing the data protected
+ * by the nb_sequences counters starting at sequences. Writers must
+ * not run concurrently.
+ */
+inline void seqlock_begin_write(Sequence* sequences, std::size_t nb_sequences)
+{
+    for (std::size_t i = 0; i < nb_sequences; i++)
+    {
+        std::uint64_t value = sequences[i].load(std::memory_order_relaxed);
+        sequences[i].store(value + 1, std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+/**
+ * @brief to be called by a writer after writing the data protected
+ * by the nb_sequences counters starting at sequences
+ */
+inline void seqlock_end_write(Sequence* sequences, std::size_t nb_sequences)
+{
+    for (std::size_t i = 0; i < nb_sequences; i++)
+    {
+        std::uint64_t value = sequences[i].load(std::memory_order_relaxed);
+        sequences[i].store(value + 1, std::memory_order_release);
+    }
+}
+
+/**
+ * @brief waits until no write is in progress and returns the value of
+ * sequence, to be passed to seqlock_unchanged once the data it protects
+ * has been read
+ */
+inline std::uint64_t seqlock_snapshot(const Sequence* sequence)
+{
+    while (true)
+    {
+        std::uint64_t value = sequence->load(std::memory_order_acquire);
+        if (value % 2 == 0)
+        {
+            return value;
+        }
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief true if no write occurred since seqlock_snapshot returned
+ * snapshot, i.e. if the data read meanwhile is not torn
+ */
+inline bool seqlock_unchanged(const Sequence* sequence, std::uint64_t snapshot)
+{
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return sequence->load(std::memory_order_relaxed) == snapshot;
+}
+
+/**
+ * @brief calls copy (which copies the data protected by the nb_sequences
+ * counters starting at sequences) until no write occurred during the
+ * copy.
+ */
+template <typename Copy>
+void seqlock_read(const Sequence* sequences,
+                  std::size_t nb_sequences,
+                  Copy copy)
+{
+    while (true)
+    {
+        // counters only increase: their sum is unchanged
+        // only if none of them changed
+        std::uint64_t before = 0;
+        bool writing = false;
+        for (std::size_t i = 0; i < nb_sequences; i++)
+        {
+            std::uint64_t value =
+                sequences[i].load(std::memory_order_acquire);
+            writing = writing || (value % 2 == 1);
+            before += value;
+        }
+        if (writing)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        copy();
+        std::atomic_thread_fence(std::memory_order_acquire);
+        std::uint64_t after = 0;
+        for (std::size_t i = 0; i < nb_sequences; i++)
+        {
+            after += sequences[i].load(std::memory_order_relaxed);
+        }
+        if (after == before)
+        {
+            return;
+        }
+    }
+}
+
+}  // namespace internal
+
+}  // namespace shared_memory
@@ -0,0 +1,115 @@
+/**
+ * @file object_handle.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2019, New York University and Max Planck
+ * Gesellschaft.
+ *
+ * @brief Declares a handle over an object of a shared memory segment, for
+ * accessing the object without looking it up by name at each call.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <Eigen/Dense>
+
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+#include <boost/interprocess/sync/scoped_lock.hpp>
+
+#include "shared_memory/exceptions.hpp"
+#include "shared_memory/internal/copy.hpp"
+#include "shared_memory/internal/object_header.hpp"
+
+namespace shared_memory
+{
+/**
+ * @brief An ObjectHandle binds the address and the size of an object of
+ * a shared memory segment, as well as the mutex and the synchronization
+ * policy (see ObjectSync) used to access it. Setting and getting the
+ * object via a handle is equivalent to calling shared_memory::set and
+ * shared_memory::get, minus the lookups of the segment and of the
+ * object by name.
+ * Instances are obtained via shared_memory::get_handle. A handle becomes
+ * invalid when its segment or its object is deleted.
+ */
+template <typename ElemType>
+class ObjectHandle
+{
+public:
+    /**
+     * @brief to be called via shared_memory::get_handle
+     */
+    ObjectHandle(const std::string& segment_id,
+                 const std::string& object_id,
+                 ElemType* shared_data,
+                 std::size_t size,
+                 boost::interprocess::interprocess_mutex* mutex,
+                 internal::ObjectHeader* header);
+
+    /**
+     * @brief writes size items into the shared object. Throws an
+     * Unexpected_size_exception if size is not the size of the object.
+     */
+    void set(const ElemType* set_, std::size_t size);
+
+    /**
+     * @brief writes the value into the shared object (of size 1)
+     */
+    void set(const ElemType& set_);
+
+    /**
+     * @brief writes the vector into the shared object
+     */
+    void set(const std::vector<ElemType>& set_);
+
+    /**
+     * @brief writes the Eigen vector into the shared object
+     */
+    void set(const Eigen::Matrix<ElemType, Eigen::Dynamic, 1>& set_);
+
+    /**
+     * @brief reads size items from the shared object. Throws an
+     * Unexpected_size_exception if size is not the size of the object.
+     */
+    void get(ElemType* get_, std::size_t size);
+
+    /**
+     * @brief reads the shared object (of size 1) into the value
+     */
+    void get(ElemType& get_);
+
+    /**
+     * @brief reads the shared object into the vector (which should be
+     * of the size of the object)
+     */
+    void get(std::vector<ElemType>& get_);
+
+    /**
+     * @brief reads the shared object into the Eigen vector (which should be
+     * of the size of the object)
+     */
+    void get(Eigen::Matrix<ElemType, Eigen::Dynamic, 1>& get_);
+
+    /**
+     * @brief number of ElemType of the shared object
+     */
+    std::size_t size() const;
+
+private:
+    void check_size(std::size_t size) const;
+
+private:
+    std::string segment_id_;
+    std::string object_id_;
+    ElemType* shared_data_;
+    std::size_t size_;
+    boost::interprocess::interprocess_mutex* mutex_;
+    // nullptr if the object uses the SEGMENT_MUTEX policy
+    internal::ObjectHeader* header_;
+};
+
+#include "shared_memory/object_handle.hxx"
+
+}  // namespace shared_memory
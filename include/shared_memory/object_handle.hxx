@@ -0,0 +1,113 @@
+/**
+ * @file object_handle.hxx
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2019, New York University and Max Planck
+ * Gesellschaft.
+ *
+ * @brief Implements the template methods of ObjectHandle
+ */
+
+template <typename ElemType>
+ObjectHandle<ElemType>::ObjectHandle(
+    const std::string& segment_id,
+    const std::string& object_id,
+    ElemType* shared_data,
+    std::size_t size,
+    boost::interprocess::interprocess_mutex* mutex,
+    internal::ObjectHeader* header)
+    : segment_id_(segment_id),
+      object_id_(object_id),
+      shared_data_(shared_data),
+      size_(size),
+      mutex_(mutex),
+      header_(header)
+{
+}
+
+template <typename ElemType>
+void ObjectHandle<ElemType>::check_size(std::size_t size) const
+{
+    if (size != size_)
+    {
+        throw shared_memory::Unexpected_size_exception(
+            segment_id_, object_id_, size_, size);
+    }
+}
+
+template <typename ElemType>
+void ObjectHandle<ElemType>::set(const ElemType* set_, std::size_t size)
+{
+    check_size(size);
+
+    if (header_ != nullptr)
+    {
+        header_->write(shared_data_, set_, size_);
+        return;
+    }
+
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>
+        lock(*mutex_);
+
+    internal::copy(shared_data_, set_, size_);
+}
+
+template <typename ElemType>
+void ObjectHandle<ElemType>::set(const ElemType& set_)
+{
+    set(&set_, 1);
+}
+
+template <typename ElemType>
+void ObjectHandle<ElemType>::set(const std::vector<ElemType>& set_)
+{
+    set(set_.data(), set_.size());
+}
+
+template <typename ElemType>
+void ObjectHandle<ElemType>::set(
+    const Eigen::Matrix<ElemType, Eigen::Dynamic, 1>& set_)
+{
+    set(set_.data(), set_.size());
+}
+
+template <typename ElemType>
+void ObjectHandle<ElemType>::get(ElemType* get_, std::size_t size)
+{
+    check_size(size);
+
+    if (header_ != nullptr)
+    {
+        header_->read(shared_data_, get_, size_);
+        return;
+    }
+
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>
+        lock(*mutex_);
+
+    internal::copy(get_, shared_data_, size_);
+}
+
+template <typename ElemType>
+void ObjectHandle<ElemType>::get(ElemType& get_)
+{
+    get(&get_, 1);
+}
+
+template <typename ElemType>
+void ObjectHandle<ElemType>::get(std::vector<ElemType>& get_)
+{
+    get(get_.data(), get_.size());
+}
+
+template <typename ElemType>
+void ObjectHandle<ElemType>::get(
+    Eigen::Matrix<ElemType, Eigen::Dynamic, 1>& get_)
+{
+    get(get_.data(), get_.size());
+}
+
+template <typename ElemType>
+std::size_t ObjectHandle<ElemType>::size() const
+{
+    return size_;
+}
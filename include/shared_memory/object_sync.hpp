@@ -0,0 +1,48 @@
+/**
+ * @file object_sync.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2019, New York University and Max Planck
+ * Gesellschaft.
+ *
+ * @brief Declares the synchronization policies of the objects of a segment
+ */
+
+#pragma once
+
+namespace shared_memory
+{
+/**
+ * @brief Synchronization policy of an object stored in a segment.
+ *
+ * - SEGMENT_MUTEX (the default): all reads and writes lock the mutex of
+ *   the segment, i.e. accesses to all objects of the segment are
+ *   serialized.
+ * - SEQLOCK: writers lock a mutex dedicated to the object and increment a
+ *   sequence counter stored next to the object before and after writing.
+ *   Readers do not lock: they copy the object and copy it again if the
+ *   sequence counter shows that a write occurred meanwhile. Suitable for
+ *   objects of trivially copyable types read at high frequency.
+ * - OBJECT_MUTEX: reads and writes lock a mutex dedicated to the object,
+ *   stored next to the object. Accesses to an object do not block accesses
+ *   to other objects of the segment.
+ *
+ * Objects with a policy other than SEGMENT_MUTEX still lock the mutex
+ * of the segment when accessed for the first time by a process
+ * (i.e. when registered). The policy is recorded in the segment by the
+ * process creating the object, see shared_memory::create_object.
+ *
+ * Lock order: when both are held, the mutex of the segment is always
+ * locked before the mutex of an object (e.g. by the first access to an
+ * object, or by Batch::commit). A thread holding the mutex of an object
+ * (i.e. owning a ReadView of an OBJECT_MUTEX object) must therefore not
+ * lock the segment mutex, i.e. must not access SEGMENT_MUTEX objects,
+ * register objects or commit batches of the segment until it releases it.
+ */
+enum ObjectSync
+{
+    SEGMENT_MUTEX,
+    SEQLOCK,
+    OBJECT_MUTEX
+};
+
+}  // namespace shared_memory
@@ -0,0 +1,142 @@
+/**
+ * @file read_view.hpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2019, New York University and Max Planck
+ * Gesellschaft.
+ *
+ * @brief Declares a read only view over an object of a shared memory
+ * segment, for reading the object without copying it.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <Eigen/Dense>
+
+#include <boost/interprocess/sync/interprocess_mutex.hpp>
+
+#include "shared_memory/internal/seqlock.hpp"
+
+namespace shared_memory
+{
+/**
+ * @brief A ReadView gives direct (read only) access to the items of an
+ * object of a shared memory segment. Unless the object has been created with
+ * the SEQLOCK policy (see ObjectSync), the view holds the lock writers of the
+ * object wait on (the segment mutex, or the mutex of the object for the
+ * OBJECT_MUTEX policy) from its construction to its destruction, so the items
+ * can not change while they are being read. Views should therefore be short
+ * lived, and the thread owning a view should not set or get objects
+ * protected by the same mutex.
+ * For objects with the SEGMENT_MUTEX policy (the default), this means the
+ * whole segment is locked for the lifetime of the view: no object of the
+ * segment can be set or gotten meanwhile, by any process, and the thread
+ * owning the view deadlocks if it sets or gets any object of the segment
+ * (or registers one, or commits a batch) before destroying the view.
+ * Views of OBJECT_MUTEX objects hold the mutex of the object: as the
+ * segment mutex is always locked first (see ObjectSync), the thread owning
+ * such a view must not access SEGMENT_MUTEX objects of the segment,
+ * register objects or commit batches before destroying the view.
+ * get_read_view does not wait for the mutex of the object while holding
+ * the segment mutex.
+ * Views of SEQLOCK objects do not lock out writers: they record the sequence
+ * counter of the object, and valid() tells if a write occurred since, in
+ * which case the items read may be torn and should be read again after
+ * calling retry():
+ * @code
+ * while (true)
+ * {
+ *     double sum = view.eigen().sum();
+ *     if (view.valid()) break;
+ *     view.retry();
+ * }
+ * @endcode
+ * Instances are obtained via shared_memory::get_read_view. A view becomes
+ * invalid when its segment or its object is deleted.
+ */
+template <typename ElemType>
+class ReadView
+{
+public:
+    /**
+     * @brief to be called via shared_memory::get_read_view, with the mutex
+     * locked. The view releases the mutex on destruction.
+     */
+    ReadView(const ElemType* shared_data,
+             std::size_t size,
+             boost::interprocess::interprocess_mutex* mutex);
+
+    /**
+     * @brief to be called via shared_memory::get_read_view, for objects
+     * with the SEQLOCK policy. Waits for the write in progress (if any)
+     * and records the sequence counter of the object.
+     */
+    ReadView(const ElemType* shared_data,
+             std::size_t size,
+             const internal::Sequence* sequence);
+
+    /**
+     * @brief releases the mutex (if any)
+     */
+    ~ReadView();
+
+    ReadView(const ReadView&) = delete;
+    ReadView& operator=(const ReadView&) = delete;
+
+    /**
+     * @brief transfers the ownership of the lock to the new instance
+     */
+    ReadView(ReadView&& other) noexcept;
+
+    /**
+     * @brief false if the object has been written since the view has been
+     * obtained (or since the last call to retry), i.e. if the items read
+     * meanwhile may be torn. Always true for views holding a lock.
+     */
+    bool valid() const;
+
+    /**
+     * @brief waits for the write in progress (if any) and records the
+     * sequence counter of the object again, before the items are read
+     * again. No effect for views holding a lock.
+     */
+    void retry();
+
+    /**
+     * @brief address of the first item, in the shared memory
+     */
+    const ElemType* data() const;
+
+    /**
+     * @brief number of ElemType of the shared object
+     */
+    std::size_t size() const;
+
+    const ElemType& operator[](std::size_t index) const;
+
+    const ElemType* begin() const;
+
+    const ElemType* end() const;
+
+    /**
+     * @brief Eigen vector mapped over the items of the shared object
+     */
+    Eigen::Map<const Eigen::Matrix<ElemType, Eigen::Dynamic, 1>> eigen()
+        const;
+
+private:
+    const ElemType* shared_data_;
+    std::size_t size_;
+    // nullptr once moved from, and for SEQLOCK objects
+    boost::interprocess::interprocess_mutex* mutex_;
+    // SEQLOCK objects only (nullptr otherwise): sequence counter of the
+    // object, and its value when the items started to be read
+    const internal::Sequence* sequence_;
+    std::uint64_t snapshot_;
+};
+
+#include "shared_memory/read_view.hxx"
+
+}  // namespace shared_memory
@@ -0,0 +1,109 @@
+/**
+ * @file read_view.hxx
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2019, New York University and Max Planck
+ * Gesellschaft.
+ *
+ * @brief Implements the template methods of ReadView
+ */
+
+template <typename ElemType>
+ReadView<ElemType>::ReadView(const ElemType* shared_data,
+                             std::size_t size,
+                             boost::interprocess::interprocess_mutex* mutex)
+    : shared_data_(shared_data),
+      size_(size),
+      mutex_(mutex),
+      sequence_(nullptr),
+      snapshot_(0)
+{
+}
+
+template <typename ElemType>
+ReadView<ElemType>::ReadView(const ElemType* shared_data,
+                             std::size_t size,
+                             const internal::Sequence* sequence)
+    : shared_data_(shared_data),
+      size_(size),
+      mutex_(nullptr),
+      sequence_(sequence),
+      snapshot_(internal::seqlock_snapshot(sequence))
+{
+}
+
+template <typename ElemType>
+ReadView<ElemType>::~ReadView()
+{
+    if (mutex_ != nullptr)
+    {
+        mutex_->unlock();
+    }
+}
+
+template <typename ElemType>
+ReadView<ElemType>::ReadView(ReadView&& other) noexcept
+    : shared_data_(other.shared_data_),
+      size_(other.size_),
+      mutex_(other.mutex_),
+      sequence_(other.sequence_),
+      snapshot_(other.snapshot_)
+{
+    other.mutex_ = nullptr;
+}
+
+template <typename ElemType>
+bool ReadView<ElemType>::valid() const
+{
+    if (sequence_ == nullptr)
+    {
+        return true;
+    }
+    return internal::seqlock_unchanged(sequence_, snapshot_);
+}
+
+template <typename ElemType>
+void ReadView<ElemType>::retry()
+{
+    if (sequence_ != nullptr)
+    {
+        snapshot_ = internal::seqlock_snapshot(sequence_);
+    }
+}
+
+template <typename ElemType>
+const ElemType* ReadView<ElemType>::data() const
+{
+    return shared_data_;
+}
+
+template <typename ElemType>
+std::size_t ReadView<ElemType>::size() const
+{
+    return size_;
+}
+
+template <typename ElemType>
+const ElemType& ReadView<ElemType>::operator[](std::size_t index) const
+{
+    return shared_data_[index];
+}
+
+template <typename ElemType>
+const ElemType* ReadView<ElemType>::begin() const
+{
+    return shared_data_;
+}
+
+template <typename ElemType>
+const ElemType* ReadView<ElemType>::end() const
+{
+    return shared_data_ + size_;
+}
+
+template <typename ElemType>
+Eigen::Map<const Eigen::Matrix<ElemType, Eigen::Dynamic, 1>>
+ReadView<ElemType>::eigen() const
+{
+    return Eigen::Map<const Eigen::Matrix<ElemType, Eigen::Dynamic, 1>>(
+        shared_data_, size_);
+}
@@ -0,0 +1,140 @@
+// Copyright (c) 2019 Max Planck Gesellschaft
+// Author : Vincent Berenz
+
+#pragma once
+
+#include <algorithm>
+#include <string>
+
+#include "shared_memory/array.hpp"
+#include "shared_memory/internal/ring_buffer_indexes.hpp"
+
+namespace shared_memory
+{
+/**
+ * @brief number of processes (or threads) allowed to pop items
+ * from a shared_memory::ring_buffer
+ */
+enum RingBufferConsumers
+{
+    SINGLE_CONSUMER,
+    MULTIPLE_CONSUMERS
+};
+
+/**
+ * @brief behavior of a shared_memory::ring_buffer when an item is pushed
+ * while it is full
+ */
+enum RingBufferOverflow
+{
+    /**
+     * @brief the item is not pushed (try_push returns false)
+     */
+    REJECT_NEWEST,
+    /**
+     * @brief the item replaces the oldest item not popped yet,
+     * which is lost
+     */
+    OVERWRITE_OLDEST
+};
+
+/**
+ * Implement a lock free bounded queue (first in, first out) stored on a
+ * shared memory segment, with a single producer and one or several
+ * consumers. Items are stored in a shared_memory::array (and may be of any
+ * type supported by shared_memory::array), the positions of the producer
+ * and of the consumers are atomics stored in the same segment.
+ * Only one instance (in one thread of one process) may push items. If
+ * constructed with SINGLE_CONSUMER, only one instance may pop items.
+ * All the instances pointing to the same segment should be constructed
+ * with the same arguments.
+ */
+template <typename T, int SIZE = 0>
+class ring_buffer
+{
+public:
+    /**
+     * @param segment_id should be the same for all ring buffers
+     * pointing to the same shared memory segment
+     * @param capacity max number of items stored by the buffer
+     * @param clear_on_destruction if true, the shared memory segment
+     * will be wiped on destruction of the buffer (see
+     * shared_memory::array)
+     * @param consumers if SINGLE_CONSUMER, a single instance may pop items
+     * @param overflow behavior when pushing into a full buffer
+     */
+    ring_buffer(std::string segment_id,
+                std::size_t capacity,
+                bool clear_on_destruction = true,
+                RingBufferConsumers consumers = SINGLE_CONSUMER,
+                RingBufferOverflow overflow = REJECT_NEWEST);
+
+    ring_buffer(const ring_buffer<T, SIZE>& other) = delete;
+    ring_buffer<T, SIZE>& operator=(const ring_buffer<T, SIZE>& other) =
+        delete;
+
+    /**
+     * @brief push the item, returns false if the buffer is full
+     * (and constructed with REJECT_NEWEST). To be called by the single
+     * producer.
+     */
+    bool try_push(const T& item);
+
+    /**
+     * @brief push (at most) nb_items items, returns the number of items
+     * pushed, which is less than nb_items if the buffer got full (and
+     * constructed with REJECT_NEWEST). For arrays of fundamental types
+     * (SIZE > 0), items points to nb_items * SIZE values. To be called by
+     * the single producer.
+     */
+    std::size_t try_push(const T* items, std::size_t nb_items);
+
+    /**
+     * @brief pop the oldest item into item, returns false if the buffer
+     * is empty
+     */
+    bool try_pop(T& item);
+
+    /**
+     * @brief pop (at most) max_items of the oldest items into items,
+     * returns the number of items popped. For arrays of fundamental types
+     * (SIZE > 0), items points to max_items * SIZE values.
+     */
+    std::size_t try_pop(T* items, std::size_t max_items);
+
+    /**
+     * @brief number of items pushed and not popped yet
+     * (only indicative while items are pushed or popped)
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief max number of items stored by the buffer
+     */
+    std::size_t capacity() const;
+
+private:
+    // write the items at position (wrapping around the end of the array)
+    void write(std::uint64_t position, const T* items, std::size_t nb_items);
+    // read the items at position (wrapping around the end of the array)
+    void read(std::uint64_t position, T* items, std::size_t nb_items);
+    // move the tail from expected to desired, returns false (and set
+    // expected to the current tail) if another consumer moved it first
+    bool move_tail(std::uint64_t& expected, std::uint64_t desired);
+    // the indexes, stored in the segment of the array
+    static internal::SegmentSizer get_indexes_object(
+        const std::string& segment_id);
+
+private:
+    std::size_t capacity_;
+    RingBufferConsumers consumers_;
+    RingBufferOverflow overflow_;
+    // number of T values per item
+    std::size_t item_values_;
+    array<T, SIZE> items_;
+    internal::RingBufferIndexes* indexes_;
+};
+
+#include "ring_buffer.hxx"
+
+}  // namespace shared_memory
@@ -0,0 +1,189 @@
+// Copyright (c) 2019 Max Planck Gesellschaft
+// Author : Vincent Berenz
+
+template <typename T, int SIZE>
+ring_buffer<T, SIZE>::ring_buffer(std::string segment_id,
+                                  std::size_t capacity,
+                                  bool clear_on_destruction,
+                                  RingBufferConsumers consumers,
+                                  RingBufferOverflow overflow)
+    : capacity_(capacity),
+      consumers_(consumers),
+      overflow_(overflow),
+      item_values_(SIZE == 0 ? 1 : SIZE),
+      // items that may be overwritten while being read (by the producer
+      // overwriting the oldest items, or because another consumer popped
+      // them) are protected by sequence counters, so that consumers never
+      // deserialize torn items
+      items_(segment_id,
+             capacity,
+             clear_on_destruction,
+             consumers == SINGLE_CONSUMER && overflow == REJECT_NEWEST
+                 ? ARRAY_UNSYNCHRONIZED
+                 : ARRAY_SINGLE_WRITER,
+             false,
+             false,
+             false,
+             get_indexes_object(segment_id))
+{
+    if (capacity_ == 0)
+    {
+        throw std::runtime_error("ring buffer of capacity 0");
+    }
+    indexes_ = items_.mapping_->segment
+                   .template find_or_construct<internal::RingBufferIndexes>(
+                       (segment_id + std::string("_indexes")).c_str())();
+}
+
+template <typename T, int SIZE>
+internal::SegmentSizer ring_buffer<T, SIZE>::get_indexes_object(
+    const std::string& segment_id)
+{
+    internal::SegmentSizer sizer;
+    sizer.add<internal::RingBufferIndexes>(segment_id +
+                                           std::string("_indexes"));
+    return sizer;
+}
+
+template <typename T, int SIZE>
+void ring_buffer<T, SIZE>::write(std::uint64_t position,
+                                 const T* items,
+                                 std::size_t nb_items)
+{
+    std::size_t slot = position % capacity_;
+    std::size_t first = std::min(nb_items, capacity_ - slot);
+    items_.set_range(slot, items, first);
+    if (first < nb_items)
+    {
+        items_.set_range(0, items + first * item_values_, nb_items - first);
+    }
+}
+
+template <typename T, int SIZE>
+void ring_buffer<T, SIZE>::read(std::uint64_t position,
+                                T* items,
+                                std::size_t nb_items)
+{
+    std::size_t slot = position % capacity_;
+    std::size_t first = std::min(nb_items, capacity_ - slot);
+    items_.get_range(slot, items, first);
+    if (first < nb_items)
+    {
+        items_.get_range(0, items + first * item_values_, nb_items - first);
+    }
+}
+
+template <typename T, int SIZE>
+bool ring_buffer<T, SIZE>::move_tail(std::uint64_t& expected,
+                                     std::uint64_t desired)
+{
+    if (consumers_ == SINGLE_CONSUMER)
+    {
+        indexes_->tail.store(desired, std::memory_order_release);
+        return true;
+    }
+    return indexes_->tail.compare_exchange_strong(
+        expected, desired, std::memory_order_acq_rel);
+}
+
+template <typename T, int SIZE>
+bool ring_buffer<T, SIZE>::try_push(const T& item)
+{
+    return try_push(&item, 1) == 1;
+}
+
+template <typename T, int SIZE>
+std::size_t ring_buffer<T, SIZE>::try_push(const T* items,
+                                           std::size_t nb_items)
+{
+    // only the producer writes the head
+    std::uint64_t head = indexes_->head.load(std::memory_order_relaxed);
+
+    if (overflow_ == REJECT_NEWEST)
+    {
+        std::uint64_t tail = indexes_->tail.load(std::memory_order_acquire);
+        nb_items = std::min(nb_items,
+                            capacity_ - static_cast<std::size_t>(head - tail));
+        if (nb_items == 0)
+        {
+            return 0;
+        }
+        write(head, items, nb_items);
+        indexes_->head.store(head + nb_items, std::memory_order_release);
+        return nb_items;
+    }
+
+    // OVERWRITE_OLDEST: only the last capacity items may be read
+    std::size_t skipped = nb_items > capacity_ ? nb_items - capacity_ : 0;
+    // consumers check the claimed position after reading items, and retry
+    // if the items they read may have been overwritten. Storing it before
+    // writing the items is enough, as writing the items starts with a
+    // release fence (array of mode ARRAY_SINGLE_WRITER)
+    indexes_->claimed.store(head + nb_items, std::memory_order_relaxed);
+    write(head + skipped,
+          items + skipped * item_values_,
+          nb_items - skipped);
+    indexes_->head.store(head + nb_items, std::memory_order_release);
+    return nb_items;
+}
+
+template <typename T, int SIZE>
+bool ring_buffer<T, SIZE>::try_pop(T& item)
+{
+    return try_pop(&item, 1) == 1;
+}
+
+template <typename T, int SIZE>
+std::size_t ring_buffer<T, SIZE>::try_pop(T* items, std::size_t max_items)
+{
+    std::uint64_t tail = indexes_->tail.load(std::memory_order_acquire);
+    while (true)
+    {
+        std::uint64_t head = indexes_->head.load(std::memory_order_acquire);
+        if (overflow_ == OVERWRITE_OLDEST && head - tail > capacity_)
+        {
+            // the producer overwrote items not popped yet, skipping to
+            // the oldest item still available
+            move_tail(tail, head - capacity_);
+            tail = indexes_->tail.load(std::memory_order_acquire);
+            continue;
+        }
+        if (head == tail || max_items == 0)
+        {
+            return 0;
+        }
+        std::size_t nb_items =
+            std::min(max_items, static_cast<std::size_t>(head - tail));
+        read(tail, items, nb_items);
+        if (overflow_ == OVERWRITE_OLDEST &&
+            indexes_->claimed.load(std::memory_order_acquire) >
+                tail + capacity_)
+        {
+            // (some of) the items read may have been overwritten
+            tail = indexes_->tail.load(std::memory_order_acquire);
+            continue;
+        }
+        if (move_tail(tail, tail + nb_items))
+        {
+            return nb_items;
+        }
+    }
+}
+
+template <typename T, int SIZE>
+std::size_t ring_buffer<T, SIZE>::size() const
+{
+    std::uint64_t tail = indexes_->tail.load(std::memory_order_acquire);
+    std::uint64_t head = indexes_->head.load(std::memory_order_acquire);
+    if (head < tail)
+    {
+        return 0;
+    }
+    return std::min(capacity_, static_cast<std::size_t>(head - tail));
+}
+
+template <typename T, int SIZE>
+std::size_t ring_buffer<T, SIZE>::capacity() const
+{
+    return capacity_;
+}
@@ -8,8 +8,11 @@
 #include <cereal/types/array.hpp>
 #include <cereal/types/vector.hpp>
 #include <sstream>
+#include <stdexcept>
 #include <utility>
 
+#include "shared_memory/internal/char_streambuf.hpp"
+
 namespace shared_memory
 {
 typedef cereal::access private_serialization;
@@ -35,6 +38,20 @@ public:
      */
     const std::string& serialize(const Serializable& serializable);
 
+    /**
+     * @brief serialize an instance into the size chars of data (see
+     * serialize), in place (no copy, no allocation). Throws a
+     * std::runtime_error if the serialized instance is larger than size
+     * chars.
+     * @param instance to serialize
+     * @param chars the instance is serialized into
+     * @param number of chars of data
+     * @return the number of chars of the serialized instance
+     */
+    std::size_t serialize(const Serializable& serializable,
+                          char* data,
+                          std::size_t size);
+
     /**
      * @brief Restore the instance of serializable based on
      * the string data, which should have been generated via
@@ -44,6 +61,18 @@ public:
      */
     void deserialize(const std::string& data, Serializable& serializable);
 
+    /**
+     * @brief Restore the instance of serializable based on the size
+     * chars of data, which should have been generated via the serialize
+     * function. The chars are read in place (no copy, no allocation).
+     * @param the serialized instance
+     * @param the number of chars of the serialized instance
+     * @param instance of Serializable to be restored
+     */
+    void deserialize(const char* data,
+                     std::size_t size,
+                     Serializable& serializable);
+
 public:
     /**
      * Returns the serialized size (i.e. the size of the string)
@@ -12,12 +12,41 @@ const std::string& Serializer<Serializable>::serialize(
     return data_;
 }
 
+template <class Serializable>
+std::size_t Serializer<Serializable>::serialize(
+    const Serializable& serializable, char* data, std::size_t size)
+{
+    internal::CharOutStreambuf buffer(data, size);
+    std::ostream os(&buffer);
+    cereal::BinaryOutputArchive boa(os);
+    try
+    {
+        boa(serializable);
+    }
+    catch (const cereal::Exception&)
+    {
+        // cereal throws when the buffer refuses chars
+        throw std::runtime_error(
+            "serializer: serialized instance larger than the buffer");
+    }
+    return buffer.size();
+}
+
 template <class Serializable>
 void Serializer<Serializable>::deserialize(const std::string& data,
                                            Serializable& serializable)
 {
-    std::stringstream ss(data);
-    cereal::BinaryInputArchive bia(ss);
+    deserialize(data.data(), data.size(), serializable);
+}
+
+template <class Serializable>
+void Serializer<Serializable>::deserialize(const char* data,
+                                           std::size_t size,
+                                           Serializable& serializable)
+{
+    internal::CharStreambuf buffer(data, size);
+    std::istream is(&buffer);
+    cereal::BinaryInputArchive bia(is);
     bia(serializable);
 }
 
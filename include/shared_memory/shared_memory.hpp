@@ -17,11 +17,14 @@
 #ifndef SHARED_MEMORY_HPP
 #define SHARED_MEMORY_HPP
 
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <map>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include <Eigen/Dense>
@@ -32,7 +35,13 @@
 #include <boost/interprocess/containers/vector.hpp>
 #include <boost/interprocess/managed_shared_memory.hpp>
 
+#include "shared_memory/batch.hpp"
 #include "shared_memory/exceptions.hpp"
+#include "shared_memory/internal/huge_pages.hpp"
+#include "shared_memory/internal/object_header.hpp"
+#include "shared_memory/object_handle.hpp"
+#include "shared_memory/object_sync.hpp"
+#include "shared_memory/read_view.hpp"
 #include "shared_memory/segment_info.hpp"
 #include "shared_memory/serializer.hpp"
 
@@ -78,6 +87,12 @@ void set_default_segment_sizes();
  */
 typedef std::map<std::string, std::pair<void*, std::size_t>> ShmObjects;
 
+/**
+ * @brief ShmHeaders maps the objects created with a synchronization policy
+ * other than SEGMENT_MUTEX to their header in the shared memory.
+ */
+typedef std::map<std::string, internal::ObjectHeader*> ShmHeaders;
+
 /**
  * @brief ShmTypeHelper is a small struct that allow the definition of
  * templated typedef.
@@ -131,10 +146,20 @@ class SharedMemorySegment
 public:
     /**
      * @brief SharedMemorySegment constructor.
+     * @param huge_pages if true, the mappings of the segment are backed
+     * by huge pages, which reduces TLB misses when scanning large objects.
+     * The kernel is advised to use transparent huge pages (madvise
+     * MADV_HUGEPAGE) right after the segment is mapped, which requires
+     * /dev/shm to be mounted with huge pages enabled (e.g. mount -o
+     * remount,huge=advise /dev/shm). If huge pages are not available,
+     * the segment is backed by regular pages. Huge pages cover only the
+     * 2MB aligned parts of a segment, i.e. this is relevant for large
+     * segments only.
      */
     SharedMemorySegment(std::string segment_id,
                         bool clear_upon_destruction,
-                        bool create);
+                        bool create,
+                        bool huge_pages = false);
 
     /**
      * @brief SharedMemorySegment destructor.
@@ -170,6 +195,19 @@ public:
      */
     void get_object(const std::string& object_id, std::string& get_);
 
+    /**
+     * @brief get_object copies the chars of the object into the buffer
+     * provided by the caller.
+     * @param[in] object_id: the name of the object in the shared memory.
+     * @param[out] get_: the buffer, of at least capacity chars.
+     * @param[in] capacity: the size of the buffer. Throws an
+     * Unexpected_size_exception if the object has more chars.
+     * @return the number of chars of the object
+     */
+    std::size_t get_object(const std::string& object_id,
+                           char* get_,
+                           std::size_t capacity);
+
     /**
      * @brief set_object registers the object in the current struc and in the
      * shared memory once only. And returns the pointer to the object and its
@@ -202,6 +240,51 @@ public:
     template <typename ElemType>
     bool register_object_read_only(const std::string& object_id);
 
+    /**
+     * @brief create_object creates the object in the segment with the
+     * specified synchronization policy. If the object already exists in the
+     * segment, it keeps the policy it has been created with.
+     * @param object_id is the name of the object to create.
+     * @param size is the number of ElemType of the object.
+     * @param sync is the synchronization policy of the object.
+     * @return true if a new object has been created
+     */
+    template <typename ElemType>
+    bool create_object(const std::string& object_id,
+                       std::size_t size,
+                       ObjectSync sync);
+
+    /**
+     * @brief get_handle registers the object (creating it in the shared
+     * memory if it does not exist yet) and returns a handle binding its
+     * address, its size and its synchronization policy.
+     * @param object_id is the name of the object in the shared memory.
+     * @param size is the number of ElemType of the object.
+     * @return a handle over the object
+     */
+    template <typename ElemType>
+    ObjectHandle<ElemType> get_handle(const std::string& object_id,
+                                      std::size_t size);
+
+    /**
+     * @brief get_read_view registers the object and returns a view over
+     * its items, locking the mutex writers of the object wait on until the
+     * view is destroyed (except for SEQLOCK objects, whose views are
+     * validated with the sequence counter of the object, see ReadView).
+     * @param object_id is the name of the object in the shared memory.
+     * @param size is the expected number of ElemType of the object.
+     * @return a read only view over the object
+     */
+    template <typename ElemType>
+    ReadView<ElemType> get_read_view(const std::string& object_id,
+                                     std::size_t size);
+
+    /**
+     * @brief begin_batch returns an empty batch of sets and gets of
+     * objects of this segment (see Batch).
+     */
+    Batch begin_batch();
+
     /**
      * @brief delete_object delete and object from the shared memory.
      * @param[in] object_id: the name of the object in the shared memory.
@@ -259,6 +342,25 @@ public:
         clear_upon_destruction_ = clear_upon_destruction;
     }
 
+    /**
+     * @brief get_clear_upon_destruction is a standard getter
+     * @return true if the segment is cleared upon destruction
+     */
+    bool get_clear_upon_destruction() const
+    {
+        return clear_upon_destruction_;
+    }
+
+    /**
+     * @brief get_huge_pages is a standard getter
+     * @return true if the segment has been constructed with huge_pages
+     * and the kernel accepted to back its mapping with huge pages
+     */
+    bool get_huge_pages() const
+    {
+        return huge_pages_advised_;
+    }
+
     /**
      * @brief get_segment_id is a standard getter
      * @return the segment name
@@ -276,10 +378,31 @@ public:
     // to be const
     SegmentInfo get_info()
     {
+        boost::interprocess::scoped_lock<
+            boost::interprocess::interprocess_mutex>
+            lock(*mutex_);
+        update_mapping();
         SegmentInfo si(segment_manager_);
         return si;
     }
 
+    /**
+     * @brief set_growable sets whether the segment grows when an object
+     * does not fit in its free memory. If not (the default), an
+     * Allocation_exception is thrown instead. This setting is local to
+     * the current process: the segment grows only when objects are
+     * created by processes which set it to true.
+     * @param[in] growable: true if the segment should grow
+     */
+    void set_growable(bool growable);
+
+    /**
+     * @brief reserve grows the segment, if required, so that at least
+     * free_bytes bytes of its memory are free.
+     * @param[in] free_bytes: number of free bytes to reserve
+     */
+    void reserve(std::size_t free_bytes);
+
 private:
     /**
      * @brief shm_segment is the boost object that manages the shared memory
@@ -287,6 +410,70 @@ private:
      */
     boost::interprocess::managed_shared_memory segment_manager_;
 
+    /**
+     * @brief retired_segment_managers_ are the mappings of the segment
+     * replaced by segment_manager_ when the segment grew. They are kept
+     * mapped, so that the addresses of the objects registered before
+     * (including the segment mutex, and the addresses held by ObjectHandle
+     * and ReadView instances) remain valid.
+     */
+    std::vector<boost::interprocess::managed_shared_memory>
+        retired_segment_managers_;
+
+    /**
+     * @brief mapped_size_ is (a lower bound of) the size of the shared
+     * memory mapped by segment_manager_
+     */
+    std::size_t mapped_size_;
+
+    /**
+     * @brief growable_ is true if the segment should grow when an object
+     * does not fit in its free memory
+     */
+    bool growable_;
+
+    /**
+     * @brief huge_pages_ is true if the mappings of the segment should be
+     * backed by huge pages
+     */
+    bool huge_pages_;
+
+    /**
+     * @brief huge_pages_advised_ is true if the kernel accepted to back
+     * the current mapping of the segment with huge pages
+     */
+    bool huge_pages_advised_;
+
+    /**
+     * @brief advise_huge_pages advises the kernel to back the current
+     * mapping with huge pages, if huge_pages_ is true. Called right after
+     * the segment is mapped, before objects are looked up or constructed.
+     */
+    void advise_huge_pages();
+
+    /**
+     * @brief update_mapping maps the segment again if it has been grown
+     * (by any process) since it has been mapped. Called with the segment
+     * mutex locked, before looking up or allocating objects.
+     */
+    void update_mapping();
+
+    /**
+     * @brief grow adds (at least) extra_bytes bytes to the segment,
+     * and maps it again. Called with the segment mutex locked.
+     */
+    void grow(std::size_t extra_bytes);
+
+    /**
+     * @brief find_or_construct finds or constructs the named array of size
+     * ElemType, growing the segment if it does not fit and the segment
+     * is growable. Called with the segment mutex locked.
+     */
+    template <typename ElemType, typename... Args>
+    ElemType* find_or_construct(const std::string& name,
+                                std::size_t size,
+                                Args&&... args);
+
     /**
      * @brief objects_ are all the data stored in the segment. WARNING here we
      * use void* so the use of the set and get functions is the RESPONSABILITY
@@ -311,6 +498,53 @@ private:
     bool clear_upon_destruction_;
 
     int ravioli_;
+
+    /**
+     * @brief headers_ are the headers of the registered objects which
+     * have been created with a policy other than SEGMENT_MUTEX
+     */
+    ShmHeaders headers_;
+
+    /**
+     * @brief objects_mutex_ protects objects_ and headers_ against
+     * concurrent accesses by the threads of the current process.
+     * Insertions and removals (performed with the segment mutex locked)
+     * lock it exclusively. Lookups performed without the segment mutex
+     * (i.e. when accessing objects with a policy other than SEGMENT_MUTEX)
+     * lock it shared.
+     */
+    std::shared_mutex objects_mutex_;
+
+    /**
+     * @brief register_header fetches from the segment the header of the
+     * object, if any. The caller locks objects_mutex_ exclusively.
+     * @param object_id is the name of the registered object.
+     */
+    void register_header(const std::string& object_id);
+
+    /**
+     * @brief get_object_locked is get_object, for callers holding the
+     * segment mutex.
+     */
+    template <typename ElemType>
+    void get_object_locked(const std::string& object_id,
+                           std::pair<ElemType*, std::size_t>& get_);
+
+    /**
+     * @brief get_object_locked is get_object, for callers holding the
+     * segment mutex.
+     */
+    void get_object_locked(const std::string& object_id, std::string& get_);
+
+    /**
+     * @brief set_object_locked is set_object, for callers holding the
+     * segment mutex.
+     */
+    template <typename ElemType>
+    void set_object_locked(const std::string& object_id,
+                           const std::pair<const ElemType*, std::size_t>& set_);
+
+    friend class Batch;
 };
 
 /**************************************************
@@ -321,10 +555,15 @@ private:
  * @brief get_segment creates or give back a pointer to a SharedMemorySegment
  * object.
  * @param segment_id is the name of the shared memory segment.
+ * @param huge_pages see SharedMemorySegment. Only the value passed when
+ * the segment is first mapped by the current process matters (e.g. call
+ * get_segment(segment_id, false, true, true) before the functions
+ * below access the segment).
  */
 SharedMemorySegment& get_segment(const std::string& segment_id,
                                  const bool clear_upon_destruction = false,
-                                 const bool create = true);
+                                 const bool create = true,
+                                 const bool huge_pages = false);
 
 /**
  * @brief performs introspection on the segment
@@ -367,6 +606,98 @@ void delete_all_segment();
 template <typename ElemType>
 bool delete_object(const std::string& segment_id, const std::string& object_id);
 
+/**
+ * @brief create_object creates an object of size ElemType in the segment
+ * with the specified synchronization policy (see ObjectSync). This must be
+ * called before any set or get on the object, as objects created by set and
+ * get use the SEGMENT_MUTEX policy. Processes accessing the object via set and
+ * get will use the policy the object has been created with.
+ * @param[in] segment_id is the name of the shared memory segment.
+ * @param[in] object_id is the name of the shared memory object to create.
+ * @param[in] size is the number of ElemType of the object (1 for a single
+ * value).
+ * @param[in] sync is the synchronization policy of the object.
+ */
+template <typename ElemType>
+void create_object(const std::string& segment_id,
+                   const std::string& object_id,
+                   std::size_t size,
+                   ObjectSync sync);
+
+/**
+ * @brief get_handle returns a handle over an object of the segment, creating
+ * the object if it does not exist yet. Setting and getting the object via the
+ * handle avoids the lookups of the segment and of the object by name
+ * performed by each call to set and get. The handle becomes invalid if the
+ * segment or the object is deleted.
+ * @param[in] segment_id is the name of the shared memory segment.
+ * @param[in] object_id is the name of the shared memory object.
+ * @param[in] size is the number of ElemType of the object (1 for a single
+ * value). Throws an Unexpected_size_exception if the object exists with
+ * another size.
+ * @return a handle over the object
+ */
+template <typename ElemType>
+ObjectHandle<ElemType> get_handle(const std::string& segment_id,
+                                  const std::string& object_id,
+                                  std::size_t size = 1);
+
+/**
+ * @brief get_read_view returns a read only view over the items of an
+ * existing object of the segment, for reading them without copying them.
+ * The object can not be written (by any process) as long as the view exists,
+ * so the view should be destroyed as soon as the items have been consumed.
+ * For objects with the SEGMENT_MUTEX policy, the view locks the segment
+ * mutex: no object of the segment can be accessed until the view is
+ * destroyed, including by the thread owning the view (which would
+ * deadlock).
+ * Objects created with the SEQLOCK policy can still be written: the items
+ * read via the view are not torn only if ReadView::valid returns true after
+ * they have been read.
+ * @param[in] segment_id is the name of the shared memory segment.
+ * @param[in] object_id is the name of the shared memory object.
+ * @param[in] size is the number of ElemType of the object. Throws an
+ * Unexpected_size_exception if the object does not exist or has another size.
+ * @return a view over the object
+ */
+template <typename ElemType>
+ReadView<ElemType> get_read_view(const std::string& segment_id,
+                                 const std::string& object_id,
+                                 std::size_t size = 1);
+
+/**
+ * @brief begin_batch returns an empty batch of sets and gets of objects of
+ * the segment. Committing the batch performs all its sets and gets under a
+ * single lock of the segment mutex, so that other processes observe either
+ * none or all of its sets (see Batch).
+ * @param[in] segment_id is the name of the shared memory segment.
+ * @param[in] create : if false, raise a Non_existing_segment_exception
+              if the segment does not already exist
+ * @return an empty batch
+ */
+Batch begin_batch(const std::string& segment_id, bool create = true);
+
+/**
+ * @brief set_segment_growable sets whether the segment grows (rather than
+ * throwing an Allocation_exception) when an object created by the current
+ * process does not fit in its free memory. Other processes detect that the
+ * segment grew and map it again.
+ * @param[in] segment_id is the name of the shared memory segment.
+ * @param[in] growable : true if the segment should grow
+ */
+void set_segment_growable(const std::string& segment_id, bool growable);
+
+/**
+ * @brief reserve_segment_memory grows the segment, if required, so that at
+ * least free_bytes bytes of its memory are free. This allows to create
+ * segments of the required size upfront (segments are created with the size
+ * set via set_segment_sizes).
+ * @param[in] segment_id is the name of the shared memory segment.
+ * @param[in] free_bytes is the number of free bytes to reserve.
+ */
+void reserve_segment_memory(const std::string& segment_id,
+                            std::size_t free_bytes);
+
 /**
  * @brief get_sgement_mutex aquiere a reference to the semgent global mutex.
  * @param[in] segment_id is the name of the shared memory segment.
@@ -562,6 +893,26 @@ void get(const std::string& segment_id,
          std::string& get_,
          bool create = true);
 
+/**
+ * @brief get copies a string of the shared memory into a buffer provided
+ * by the caller, without allocating memory.
+ *
+ * @param[in] segment_id is the name of the shared memory segment.
+ * @param[in] object_id is the name of the shared memory object to get.
+ * @param[out] get_ is the buffer the chars are copied to
+ * @param[in] capacity is the size of the buffer. An
+ * Unexpected_size_exception is thrown if the string is longer.
+ * @param[out] size is set to the number of chars of the string
+ * @param[in] create : if false, raise a Non_existing_segment_exception
+              if the segment does not already exist
+ */
+void get(const std::string& segment_id,
+         const std::string& object_id,
+         char* get_,
+         std::size_t capacity,
+         std::size_t& size,
+         bool create = true);
+
 /**
  * @brief get gets a pointer to a std::vector<ElemType>
  * in the shared memory.
@@ -31,17 +31,44 @@ template <typename ElemType>
 void SharedMemorySegment::get_object(const std::string& object_id,
                                      std::pair<ElemType*, std::size_t>& get_)
 {
+    // once registered, objects created with a policy other than
+    // SEGMENT_MUTEX are read without locking the segment mutex
+    {
+        std::shared_lock<std::shared_mutex> objects_lock(objects_mutex_);
+        ShmHeaders::const_iterator header = headers_.find(object_id);
+        if (header != headers_.end())
+        {
+            ShmObjects::const_iterator object = objects_.find(object_id);
+            if (object->second.second == get_.second)
+            {
+                header->second->read(
+                    static_cast<const ElemType*>(object->second.first),
+                    get_.first,
+                    get_.second);
+                return;
+            }
+        }
+    }
+
     boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>
         lock(*mutex_);
 
+    get_object_locked<ElemType>(object_id, get_);
+}
+
+template <typename ElemType>
+void SharedMemorySegment::get_object_locked(
+    const std::string& object_id, std::pair<ElemType*, std::size_t>& get_)
+{
     // register_object(object_id, get_);
 
     bool registered = register_object_read_only<ElemType>(object_id);
-    if (objects_[object_id].second != get_.second)
+    std::size_t registered_size = objects_[object_id].second;
+    if (registered_size != get_.second)
     {
         delete_object<ElemType>(object_id);
         throw shared_memory::Unexpected_size_exception(
-            segment_id_, object_id, objects_[object_id].second, get_.second);
+            segment_id_, object_id, registered_size, get_.second);
     }
 
     if (registered && VERBOSE)
@@ -52,10 +79,13 @@ void SharedMemorySegment::get_object(const std::string& object_id,
 
     ElemType* shared_data = static_cast<ElemType*>(objects_[object_id].first);
     std::size_t shared_data_size = objects_[object_id].second;
-    for (std::size_t i = 0; i < shared_data_size; ++i)
+    ShmHeaders::const_iterator header = headers_.find(object_id);
+    if (header != headers_.end())
     {
-        get_.first[i] = shared_data[i];
+        header->second->read(shared_data, get_.first, shared_data_size);
+        return;
     }
+    internal::copy(get_.first, shared_data, shared_data_size);
 }
 
 template <typename ElemType>
@@ -63,10 +93,39 @@ void SharedMemorySegment::set_object(
     const std::string& object_id,
     const std::pair<const ElemType*, std::size_t>& set_)
 {
+    // once registered, objects created with a policy other than
+    // SEGMENT_MUTEX are written without locking the segment mutex
+    {
+        std::shared_lock<std::shared_mutex> objects_lock(objects_mutex_);
+        ShmHeaders::const_iterator header = headers_.find(object_id);
+        if (header != headers_.end())
+        {
+            ShmObjects::const_iterator object = objects_.find(object_id);
+            header->second->write(static_cast<ElemType*>(object->second.first),
+                                  set_.first,
+                                  object->second.second);
+            return;
+        }
+    }
+
     boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>
         lock(*mutex_);
 
+    set_object_locked<ElemType>(object_id, set_);
+}
+
+template <typename ElemType>
+void SharedMemorySegment::set_object_locked(
+    const std::string& object_id,
+    const std::pair<const ElemType*, std::size_t>& set_)
+{
     bool registered = register_object(object_id, set_);
+    std::size_t registered_size = objects_[object_id].second;
+    if (registered_size != set_.second)
+    {
+        throw shared_memory::Unexpected_size_exception(
+            segment_id_, object_id, registered_size, set_.second);
+    }
 
     if (registered && VERBOSE)
     {
@@ -77,10 +136,13 @@ void SharedMemorySegment::set_object(
 
     ElemType* shared_data = static_cast<ElemType*>(objects_[object_id].first);
     std::size_t shared_data_size = objects_[object_id].second;
-    for (std::size_t i = 0; i < shared_data_size; ++i)
+    ShmHeaders::const_iterator header = headers_.find(object_id);
+    if (header != headers_.end())
     {
-        shared_data[i] = set_.first[i];
+        header->second->write(shared_data, set_.first, shared_data_size);
+        return;
     }
+    internal::copy(shared_data, set_.first, shared_data_size);
 }
 
 template <typename ElemType>
@@ -95,18 +157,47 @@ bool SharedMemorySegment::register_object(
     typename std::remove_const<ElemType>::type* obj_ptr = nullptr;
 
     obj_ptr =
-        segment_manager_
-            .find_or_construct<typename std::remove_const<ElemType>::type>(
-                object_id.c_str())[obj_.second]();
-    obj_size = obj_.second;
-
+        find_or_construct<typename std::remove_const<ElemType>::type>(
+            object_id, obj_.second);
+    // the object may exist with another size
+    obj_size = segment_manager_
+                   .find<typename std::remove_const<ElemType>::type>(
+                       object_id.c_str())
+                   .second;
+
+    std::unique_lock<std::shared_mutex> objects_lock(objects_mutex_);
     objects_[object_id] = std::pair<void*, std::size_t>();
     objects_[object_id].first = static_cast<void*>(obj_ptr);
     objects_[object_id].second = obj_size;
+    register_header(object_id);
 
     return true;
 }
 
+template <typename ElemType, typename... Args>
+ElemType* SharedMemorySegment::find_or_construct(const std::string& name,
+                                                 std::size_t size,
+                                                 Args&&... args)
+{
+    update_mapping();
+    try
+    {
+        return segment_manager_.find_or_construct<ElemType>(name.c_str())[size](
+            std::forward<Args>(args)...);
+    }
+    catch (const boost::interprocess::bad_alloc&)
+    {
+        if (!growable_)
+        {
+            throw;
+        }
+    }
+    // room for the items, the name and the bookkeeping of boost
+    grow(size * sizeof(ElemType) + name.size() + 1024);
+    return segment_manager_.find_or_construct<ElemType>(name.c_str())[size](
+        std::forward<Args>(args)...);
+}
+
 template <typename ElemType>
 bool SharedMemorySegment::register_object_read_only(
     const std::string& object_id)
@@ -116,6 +207,8 @@ bool SharedMemorySegment::register_object_read_only(
         return false;
     }
 
+    update_mapping();
+
     std::size_t obj_size = 0;
     typename std::remove_const<ElemType>::type* obj_ptr = nullptr;
 
@@ -126,23 +219,160 @@ bool SharedMemorySegment::register_object_read_only(
     obj_ptr = obj_pair.first;
     obj_size = obj_pair.second;
 
+    std::unique_lock<std::shared_mutex> objects_lock(objects_mutex_);
     objects_[object_id] = std::pair<void*, std::size_t>();
     objects_[object_id].first = static_cast<void*>(obj_ptr);
     objects_[object_id].second = obj_size;
+    register_header(object_id);
 
     return true;
 }
 
+template <typename ElemType>
+bool SharedMemorySegment::create_object(const std::string& object_id,
+                                        std::size_t size,
+                                        ObjectSync sync)
+{
+    typedef typename std::remove_const<ElemType>::type Type;
+
+    if (sync == SEQLOCK && !std::is_trivially_copyable<Type>::value)
+    {
+        throw std::logic_error(
+            "shared_memory: the SEQLOCK policy requires a trivially copyable "
+            "type");
+    }
+
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>
+        lock(*mutex_);
+
+    update_mapping();
+
+    if (segment_manager_.find<Type>(object_id.c_str()).first != nullptr)
+    {
+        return false;
+    }
+
+    if (sync != SEGMENT_MUTEX)
+    {
+        // the header is created first, so that any process finding
+        // the object also finds its header (and so that the header,
+        // which hosts the mutex of the object, is allocated next to it)
+        internal::ObjectHeader* header =
+            find_or_construct<internal::ObjectHeader>(
+                internal::object_header_id(object_id),
+                1,
+                static_cast<int>(sync));
+        header->sync = static_cast<int>(sync);
+    }
+
+    std::pair<Type*, std::size_t> obj(nullptr, size);
+    return register_object(object_id, obj);
+}
+
+template <typename ElemType>
+ObjectHandle<ElemType> SharedMemorySegment::get_handle(
+    const std::string& object_id, std::size_t size)
+{
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>
+        lock(*mutex_);
+
+    std::pair<ElemType*, std::size_t> obj(nullptr, size);
+    register_object(object_id, obj);
+
+    const std::pair<void*, std::size_t>& registered = objects_[object_id];
+    if (registered.second != size)
+    {
+        throw shared_memory::Unexpected_size_exception(
+            segment_id_, object_id, registered.second, size);
+    }
+
+    internal::ObjectHeader* header = nullptr;
+    ShmHeaders::iterator header_it = headers_.find(object_id);
+    if (header_it != headers_.end())
+    {
+        header = header_it->second;
+    }
+
+    return ObjectHandle<ElemType>(segment_id_,
+                                  object_id,
+                                  static_cast<ElemType*>(registered.first),
+                                  size,
+                                  mutex_,
+                                  header);
+}
+
+template <typename ElemType>
+ReadView<ElemType> SharedMemorySegment::get_read_view(
+    const std::string& object_id, std::size_t size)
+{
+    while (true)
+    {
+        boost::interprocess::scoped_lock<
+            boost::interprocess::interprocess_mutex>
+            lock(*mutex_);
+
+        register_object_read_only<ElemType>(object_id);
+
+        const std::pair<void*, std::size_t> registered = objects_[object_id];
+        if (registered.second != size)
+        {
+            if (registered.first == nullptr)
+            {
+                // the object does not exist (yet)
+                std::unique_lock<std::shared_mutex> objects_lock(
+                    objects_mutex_);
+                objects_.erase(object_id);
+            }
+            throw shared_memory::Unexpected_size_exception(
+                segment_id_, object_id, registered.second, size);
+        }
+        const ElemType* data = static_cast<const ElemType*>(registered.first);
+
+        // the lock of the view is acquired before the segment mutex is
+        // released, so that the object can not be deleted meanwhile
+        ShmHeaders::iterator header = headers_.find(object_id);
+        if (header == headers_.end())
+        {
+            // the view keeps the lock of the segment mutex
+            lock.release();
+            return ReadView<ElemType>(data, size, mutex_);
+        }
+        if (header->second->sync == SEQLOCK)
+        {
+            return ReadView<ElemType>(data, size, &header->second->sequence);
+        }
+        // not waiting for the mutex of the object while holding the segment
+        // mutex: its owner (e.g. the thread of another view) may be waiting
+        // for the segment mutex
+        if (header->second->mutex.try_lock())
+        {
+            return ReadView<ElemType>(data, size, &header->second->mutex);
+        }
+        lock.unlock();
+        std::this_thread::yield();
+    }
+}
+
 template <typename ElemType>
 void SharedMemorySegment::delete_object(const std::string& object_id)
 {
     try
     {
-        if (objects_.count(object_id) != 0)
+        update_mapping();
         {
-            objects_.erase(object_id);
+            std::unique_lock<std::shared_mutex> objects_lock(objects_mutex_);
+            if (objects_.count(object_id) != 0)
+            {
+                objects_.erase(object_id);
+            }
+            if (headers_.count(object_id) != 0)
+            {
+                headers_.erase(object_id);
+            }
         }
         segment_manager_.destroy<ElemType>(object_id.c_str());
+        segment_manager_.destroy<internal::ObjectHeader>(
+            internal::object_header_id(object_id).c_str());
     }
     catch (const boost::interprocess::interprocess_exception&)
     {
@@ -155,19 +385,14 @@ void SharedMemorySegment::delete_object(const std::string& object_id)
  *************************************************/
 
 /**
- * @brief SegmentMap typedef is a simple short cut to the GLOBAL_SHM_SEGMENTS
- * type.
- */
-typedef std::map<std::string, std::unique_ptr<SharedMemorySegment> > SegmentMap;
-
-/**
- * @brief GLOBAL_SHARED_MEMORY_SEGMENT is global variable that acts as a
- * a shared memory manager.
+ * @brief SegmentMap typedef maps the ids of the segments used by the current
+ * process to their SharedMemorySegment. The process wide registry of segments
+ * (see get_segment) is split in several such maps.
  *
  * The use of the std::unique_ptr allows to delete the object and re-create
  * at will.
  */
-static SegmentMap GLOBAL_SHM_SEGMENTS;
+typedef std::map<std::string, std::unique_ptr<SharedMemorySegment> > SegmentMap;
 
 template <typename ElemType>
 bool delete_object(const std::string& segment_id, const std::string& object_id)
@@ -175,12 +400,58 @@ bool delete_object(const std::string& segment_id, const std::string& object_id)
     try
     {
         SharedMemorySegment& segment = get_segment(segment_id);
+        boost::interprocess::scoped_lock<
+            boost::interprocess::interprocess_mutex>
+            lock(*segment.mutex_);
         segment.delete_object<ElemType>(object_id);
     }
     catch (const boost::interprocess::interprocess_exception&)
     {
         return false;
     }
+    return true;
+}
+
+template <typename ElemType>
+void create_object(const std::string& segment_id,
+                   const std::string& object_id,
+                   std::size_t size,
+                   ObjectSync sync)
+{
+    try
+    {
+        SharedMemorySegment& segment = get_segment(segment_id);
+        segment.create_object<ElemType>(object_id, size, sync);
+    }
+    catch (const boost::interprocess::bad_alloc&)
+    {
+        throw shared_memory::Allocation_exception(segment_id, object_id);
+    }
+}
+
+template <typename ElemType>
+ObjectHandle<ElemType> get_handle(const std::string& segment_id,
+                                  const std::string& object_id,
+                                  std::size_t size)
+{
+    try
+    {
+        SharedMemorySegment& segment = get_segment(segment_id);
+        return segment.get_handle<ElemType>(object_id, size);
+    }
+    catch (const boost::interprocess::bad_alloc&)
+    {
+        throw shared_memory::Allocation_exception(segment_id, object_id);
+    }
+}
+
+template <typename ElemType>
+ReadView<ElemType> get_read_view(const std::string& segment_id,
+                                 const std::string& object_id,
+                                 std::size_t size)
+{
+    SharedMemorySegment& segment = get_segment(segment_id);
+    return segment.get_read_view<ElemType>(object_id, size);
 }
 
 /***********************************
@@ -255,8 +526,16 @@ void set(const std::string& segment_id,
          const std::string& object_id,
          const std::pair<FirstType, SecondType>& set_)
 {
-    set<FirstType>(segment_id, object_id + "_first", set_.first);
-    set<SecondType>(segment_id, object_id + "_second", set_.second);
+    try
+    {
+        Batch batch = begin_batch(segment_id);
+        batch.set(object_id, set_);
+        batch.commit();
+    }
+    catch (const boost::interprocess::bad_alloc&)
+    {
+        throw shared_memory::Allocation_exception(segment_id, object_id);
+    }
 }
 
 template <typename KeyType, typename ValueType>
@@ -266,17 +545,9 @@ void set(const std::string& segment_id,
 {
     try
     {
-        int i = 0;
-        for (typename std::map<KeyType, ValueType>::const_iterator map_it =
-                 set_.begin();
-             map_it != set_.end();
-             ++map_it)
-        {
-            set(segment_id,
-                object_id + "_" + std::to_string(i),
-                map_it->second);
-            ++i;
-        }
+        Batch batch = begin_batch(segment_id);
+        batch.set(object_id, set_);
+        batch.commit();
     }
     catch (const boost::interprocess::bad_alloc&)
     {
@@ -353,8 +624,16 @@ void get(const std::string& segment_id,
          std::pair<FirstType, SecondType>& get_,
          bool create)
 {
-    get<FirstType>(segment_id, object_id + "_first", get_.first, create);
-    get<SecondType>(segment_id, object_id + "_second", get_.second, create);
+    try
+    {
+        Batch batch = begin_batch(segment_id, create);
+        batch.get(object_id, get_);
+        batch.commit();
+    }
+    catch (const boost::interprocess::bad_alloc&)
+    {
+        throw shared_memory::Allocation_exception(segment_id, object_id);
+    }
 }
 
 template <typename KeyType, typename ValueType>
@@ -365,18 +644,9 @@ void get(const std::string& segment_id,
 {
     try
     {
-        int i = 0;
-        for (typename std::map<KeyType, ValueType>::iterator map_it =
-                 get_.begin();
-             map_it != get_.end();
-             ++map_it)
-        {
-            get(segment_id,
-                object_id + "_" + std::to_string(i),
-                map_it->second,
-                create);
-            ++i;
-        }
+        Batch batch = begin_batch(segment_id, create);
+        batch.get(object_id, get_);
+        batch.commit();
     }
     catch (const boost::interprocess::bad_alloc&)
     {
@@ -384,4 +654,6 @@ void get(const std::string& segment_id,
     }
 }
 
+#include "shared_memory/batch.hxx"
+
 }  // namespace shared_memory
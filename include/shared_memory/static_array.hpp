@@ -0,0 +1,125 @@
+// Copyright (c) 2019 Max Planck Gesellschaft
+// Author : Vincent Berenz
+
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include "shared_memory/array.hpp"
+#include "shared_memory/internal/array_layout.hpp"
+#include "shared_memory/internal/array_mapping.hpp"
+#include "shared_memory/internal/segment_sizer.hpp"
+#include "shared_memory/internal/seqlock.hpp"
+
+namespace shared_memory
+{
+/**
+ * Implement a shared array of N items of a trivially copyable type T
+ * (fundamental types included), whose capacity, item size and
+ * synchronization are template constants: the address of an item is a
+ * compile time offset from the first item, and the synchronization does
+ * not branch at runtime. Intended for real time loops, in which
+ * static_array::set_unchecked and static_array::get_unchecked
+ * also spare the check of the index.
+ * The layout (capacity, item size and alignment) is stored in the segment
+ * by the instance creating it, and checked once by the instances
+ * attaching to it: pointing a static_array to the segment of a static_array
+ * of another layout throws. Unlike shared_memory::array, a static_array
+ * does not notify updates of its items.
+ * Copies of a static_array share the mapping of its segment.
+ */
+template <typename T, std::size_t N, ArraySync SYNC = ARRAY_MUTEX>
+class static_array
+{
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "shared_memory::static_array requires a trivially "
+                  "copyable type");
+    static_assert(alignof(T) <= alignof(std::max_align_t),
+                  "shared_memory::static_array does not support over-aligned "
+                  "types");
+    static_assert(N > 0, "shared_memory::static_array of capacity 0");
+
+public:
+    /**
+     * @brief number of items
+     */
+    static constexpr std::size_t size()
+    {
+        return N;
+    }
+
+    /**
+     * @brief number of bytes between the first item and the item at index
+     */
+    static constexpr std::size_t offset(std::size_t index)
+    {
+        return index * sizeof(T);
+    }
+
+    /**
+     * @param segment_id should be the same for all static_array pointing
+     * to the same shared memory segment
+     * @param clear_on_destruction if true, the shared memory segment
+     * will be wiped on destruction of the last copy of this static_array
+     * (see shared_memory::array)
+     * @param huge_pages if true, the mapping of the segment is backed by
+     * huge pages when available (see shared_memory::SharedMemorySegment)
+     */
+    static_array(std::string segment_id,
+                 bool clear_on_destruction = true,
+                 bool huge_pages = false);
+
+    /**
+     * @brief set element t at index. Throws a std::runtime_error if index
+     * is not smaller than N
+     */
+    void set(uint index, const T& t);
+
+    /**
+     * @brief read element at index into t. Throws a std::runtime_error if
+     * index is not smaller than N
+     */
+    void get(uint index, T& t);
+
+    /**
+     * @brief set element t at index, which must be smaller than N
+     * (not checked)
+     */
+    void set_unchecked(uint index, const T& t);
+
+    /**
+     * @brief read element at index into t. The index must be smaller than
+     * N (not checked)
+     */
+    void get_unchecked(uint index, T& t);
+
+    /**
+     * @brief true if the array has been constructed with huge_pages and
+     * the kernel accepted to back the mapping of its segment with huge pages
+     */
+    bool get_huge_pages() const;
+
+    // for debug
+    void* get_raw();
+
+private:
+    void write(uint index, const T& t);
+    void read(uint index, T& t);
+
+private:
+    // segment and mutex, shared by the copies of this array
+    std::shared_ptr<internal::ArrayMapping> mapping_;
+    std::string segment_id_;
+    char* items_;
+    // one per item, nullptr unless ARRAY_SINGLE_WRITER
+    internal::Sequence* sequences_;
+};
+
+#include "static_array.hxx"
+
+}  // namespace shared_memory
@@ -0,0 +1,151 @@
+// Copyright (c) 2019 Max Planck Gesellschaft
+// Author : Vincent Berenz
+
+template <typename T, std::size_t N, ArraySync SYNC>
+static_array<T, N, SYNC>::static_array(std::string segment_id,
+                                       bool clear_on_destruction,
+                                       bool huge_pages)
+    : mapping_(std::make_shared<internal::ArrayMapping>(segment_id,
+                                                        clear_on_destruction)),
+      segment_id_(segment_id),
+      items_(nullptr),
+      sequences_(nullptr)
+{
+    // objects constructed below (in this order)
+    internal::SegmentSizer sizer;
+    sizer.add<internal::StaticArrayLayout>(segment_id_ +
+                                           std::string("_static_layout"));
+    sizer.add<char>(segment_id_, N * sizeof(T));
+    if (SYNC == ARRAY_SINGLE_WRITER)
+    {
+        sizer.add<internal::Sequence>(segment_id_ + std::string("_sequences"),
+                                      N);
+    }
+    mapping_->segment = boost::interprocess::managed_shared_memory(
+        boost::interprocess::open_or_create,
+        segment_id_.c_str(),
+        sizer.get_segment_size());
+    if (huge_pages)
+    {
+        mapping_->huge_pages = internal::advise_huge_pages(mapping_->segment);
+    }
+
+    // checking the layout once, so that accessing the items relies
+    // only on template constants
+    internal::StaticArrayLayout expected(
+        N, sizeof(T), alignof(T), static_cast<int>(SYNC));
+    internal::StaticArrayLayout* layout =
+        mapping_->segment.find_or_construct<internal::StaticArrayLayout>(
+            (segment_id_ + std::string("_static_layout")).c_str())(expected);
+    if (!(*layout == expected))
+    {
+        // the segment is used by another static_array: not wiping it
+        mapping_->clear_on_destruction = false;
+        throw std::runtime_error(
+            "static_array: the layout of segment " + segment_id_ +
+            " (capacity " + std::to_string(layout->capacity) +
+            ", item size " + std::to_string(layout->item_size) + ", sync " +
+            std::to_string(layout->sync) +
+            ") does not match the layout of the array (capacity " +
+            std::to_string(N) + ", item size " + std::to_string(sizeof(T)) +
+            ", sync " + std::to_string(static_cast<int>(SYNC)) + ")");
+    }
+
+    // items are only copied in and out with memcpy: zeroed raw memory,
+    // so that T does not have to be default constructible
+    items_ = mapping_->segment.find_or_construct<char>(
+        segment_id_.c_str())[N * sizeof(T)](0);
+    if (SYNC == ARRAY_SINGLE_WRITER)
+    {
+        sequences_ = mapping_->segment.find_or_construct<internal::Sequence>(
+            (segment_id_ + std::string("_sequences")).c_str())[N](0);
+    }
+}
+
+template <typename T, std::size_t N, ArraySync SYNC>
+void static_array<T, N, SYNC>::write(uint index, const T& t)
+{
+    char* item = items_ + offset(index);
+    if (SYNC == ARRAY_SINGLE_WRITER)
+    {
+        internal::seqlock_begin_write(&sequences_[index], 1);
+        std::memcpy(item, &t, sizeof(T));
+        internal::seqlock_end_write(&sequences_[index], 1);
+        return;
+    }
+    if (SYNC == ARRAY_MUTEX)
+    {
+        mapping_->mutex.lock();
+    }
+    std::memcpy(item, &t, sizeof(T));
+    if (SYNC == ARRAY_MUTEX)
+    {
+        mapping_->mutex.unlock();
+    }
+}
+
+template <typename T, std::size_t N, ArraySync SYNC>
+void static_array<T, N, SYNC>::read(uint index, T& t)
+{
+    const char* item = items_ + offset(index);
+    if (SYNC == ARRAY_SINGLE_WRITER)
+    {
+        internal::seqlock_read(&sequences_[index], 1, [&]() {
+            std::memcpy(&t, item, sizeof(T));
+        });
+        return;
+    }
+    if (SYNC == ARRAY_MUTEX)
+    {
+        mapping_->mutex.lock();
+    }
+    std::memcpy(&t, item, sizeof(T));
+    if (SYNC == ARRAY_MUTEX)
+    {
+        mapping_->mutex.unlock();
+    }
+}
+
+template <typename T, std::size_t N, ArraySync SYNC>
+void static_array<T, N, SYNC>::set(uint index, const T& t)
+{
+    if (index >= N)
+    {
+        throw std::runtime_error("invalid index");
+    }
+    write(index, t);
+}
+
+template <typename T, std::size_t N, ArraySync SYNC>
+void static_array<T, N, SYNC>::get(uint index, T& t)
+{
+    if (index >= N)
+    {
+        throw std::runtime_error("invalid index");
+    }
+    read(index, t);
+}
+
+template <typename T, std::size_t N, ArraySync SYNC>
+void static_array<T, N, SYNC>::set_unchecked(uint index, const T& t)
+{
+    write(index, t);
+}
+
+template <typename T, std::size_t N, ArraySync SYNC>
+void static_array<T, N, SYNC>::get_unchecked(uint index, T& t)
+{
+    read(index, t);
+}
+
+template <typename T, std::size_t N, ArraySync SYNC>
+bool static_array<T, N, SYNC>::get_huge_pages() const
+{
+    return mapping_->huge_pages;
+}
+
+template <typename T, std::size_t N, ArraySync SYNC>
+void* static_array<T, N, SYNC>::get_raw()
+{
+    return items_;
+}
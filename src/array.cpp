@@ -9,4 +9,16 @@ void clear_array(std::string segment_id)
         (segment_id + std::string("_mutex")).c_str());
 }
 
+namespace internal
+{
+ArrayMapping::~ArrayMapping()
+{
+    if (clear_on_destruction)
+    {
+        clear_array(segment_id);
+    }
+}
+
+}  // namespace internal
+
 }  // namespace shared_memory
@@ -0,0 +1,72 @@
+/**
+ * @file batch.cpp
+ * @license License BSD-3-Clause
+ * @copyright Copyright (c) 2019, New York University and Max Planck
+ * Gesellschaft.
+ *
+ * @brief Implements the non template methods of Batch
+ */
+#include "shared_memory/shared_memory.hpp"
+
+namespace shared_memory
+{
+Batch::Batch(SharedMemorySegment& segment) : segment_(&segment)
+{
+}
+
+void Batch::set(const std::string& object_id, const std::string& set_)
+{
+    set<char>(object_id, set_.c_str(), set_.size());
+}
+
+void Batch::get(const std::string& object_id, std::string& get_)
+{
+    Operation operation;
+    operation.object_id = object_id;
+    operation.data = &get_;
+    operation.size = 0;
+    operation.apply = &Batch::apply_get_string;
+    operations_.push_back(operation);
+}
+
+void Batch::apply_get_string(SharedMemorySegment& segment,
+                             const Operation& operation)
+{
+    segment.get_object_locked(operation.object_id,
+                              *static_cast<std::string*>(operation.data));
+}
+
+void Batch::commit()
+{
+    std::vector<Operation>::const_iterator operation = operations_.begin();
+    try
+    {
+        boost::interprocess::scoped_lock<
+            boost::interprocess::interprocess_mutex>
+            lock(*segment_->mutex_);
+        for (; operation != operations_.end(); ++operation)
+        {
+            operation->apply(*segment_, *operation);
+        }
+    }
+    catch (const boost::interprocess::bad_alloc&)
+    {
+        std::string object_id = operation->object_id;
+        operations_.clear();
+        throw shared_memory::Allocation_exception(
+            segment_->get_segment_id(), object_id);
+    }
+    catch (...)
+    {
+        operations_.clear();
+        throw;
+    }
+    operations_.clear();
+}
+
+std::size_t Batch::size() const
+{
+    return operations_.size();
+}
+
+}  // namespace shared_memory
@@ -0,0 +1,159 @@
+// Copyright 2019 @ Max Planck Gesellschaft and New York University
+// License BSD-3-Clause
+
+#include "shared_memory/internal/segment_sizer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+#include <boost/interprocess/indexes/iset_index.hpp>
+#include <boost/interprocess/managed_external_buffer.hpp>
+#include <boost/interprocess/managed_shared_memory.hpp>
+
+namespace shared_memory
+{
+namespace internal
+{
+namespace
+{
+typedef boost::interprocess::managed_shared_memory::memory_algorithm
+    MemoryAlgorithm;
+
+// managed like a managed_shared_memory (which uses iset_index
+// by default)
+typedef boost::interprocess::basic_managed_external_buffer<
+    char,
+    MemoryAlgorithm,
+    boost::interprocess::iset_index>
+    SizingBuffer;
+
+// a managed_shared_memory stores its initialization state before the
+// memory managed by its segment manager: the size of this header is the
+// offset its memory implementation is instantiated with
+template <class CharType,
+          class Algorithm,
+          template <class IndexConfig> class IndexType,
+          std::size_t OFFSET>
+constexpr std::size_t get_offset(
+    const boost::interprocess::ipcdetail::
+        basic_managed_memory_impl<CharType, Algorithm, IndexType, OFFSET>*)
+{
+    return OFFSET;
+}
+
+static constexpr std::size_t SEGMENT_HEADER_SIZE = get_offset(
+    static_cast<boost::interprocess::managed_shared_memory*>(nullptr));
+
+// largest alignment of the declared objects supported: segments are
+// mapped at page boundaries, so objects can not be aligned on more in
+// all processes
+static constexpr std::size_t MAX_ALIGNMENT = 4096;
+
+// same size and alignment as an item of the declared objects, but
+// constructing it does not write its memory
+template <std::size_t ALIGNMENT>
+struct alignas(ALIGNMENT) Placeholder
+{
+    Placeholder()
+    {
+    }
+    char bytes[ALIGNMENT];
+};
+
+// constructs an object of bytes chars aligned on alignment (a power
+// of two, ALIGNMENT or larger)
+template <std::size_t ALIGNMENT>
+void construct(SizingBuffer& buffer,
+               const std::string& name,
+               std::size_t bytes,
+               std::size_t alignment)
+{
+    if (alignment == ALIGNMENT)
+    {
+        buffer.construct<Placeholder<ALIGNMENT>>(
+            name.c_str())[bytes / ALIGNMENT]();
+        return;
+    }
+    construct<ALIGNMENT * 2>(buffer, name, bytes, alignment);
+}
+
+template <>
+void construct<MAX_ALIGNMENT * 2>(SizingBuffer&,
+                                  const std::string& name,
+                                  std::size_t,
+                                  std::size_t)
+{
+    throw std::logic_error("shared_memory: unsupported alignment of object " +
+                           name);
+}
+
+}  // namespace
+
+std::size_t SegmentSizer::get_header_size()
+{
+    return SEGMENT_HEADER_SIZE;
+}
+
+std::size_t SegmentSizer::get_segment_size() const
+{
+    // the memory used by an object grows by exactly as many bytes as the
+    // object, as long as the object is larger than a few units of
+    // allocation: objects are allocated with at most two units of their
+    // payload (unit: the largest alignment, so that the offsets of the
+    // objects keep their alignments), the other units being only counted
+    std::size_t unit = MemoryAlgorithm::Alignment;
+    for (const Object& object : objects_)
+    {
+        if (object.alignment == 0 || object.alignment > MAX_ALIGNMENT ||
+            (object.alignment & (object.alignment - 1)) != 0)
+        {
+            throw std::logic_error(
+                "shared_memory: unsupported alignment of object " +
+                object.name);
+        }
+        unit = std::max(unit, object.alignment);
+    }
+    std::vector<std::size_t> allocated(objects_.size());
+    std::size_t counted = 0;
+    std::size_t buffer_size = SizingBuffer::segment_manager::get_min_size();
+    for (std::size_t i = 0; i < objects_.size(); i++)
+    {
+        const Object& object = objects_[i];
+        std::size_t skipped_units = object.bytes / unit;
+        skipped_units = skipped_units > 1 ? skipped_units - 1 : 0;
+        allocated[i] = object.bytes - skipped_units * unit;
+        counted += skipped_units * unit;
+        // upper bound of the memory used by the object
+        buffer_size += allocated[i] + object.alignment + object.name.size() +
+                       MemoryAlgorithm::Alignment * 16;
+    }
+
+    // placed like the memory managed by the segment manager of a segment,
+    // which is mapped at a page boundary
+    std::size_t space = buffer_size + unit + SEGMENT_HEADER_SIZE;
+    std::unique_ptr<char[]> memory(new char[space]);
+    void* address = memory.get();
+    std::align(unit, buffer_size + SEGMENT_HEADER_SIZE, address, space);
+    SizingBuffer buffer(boost::interprocess::create_only,
+                        static_cast<char*>(address) + SEGMENT_HEADER_SIZE,
+                        buffer_size);
+
+    for (std::size_t i = 0; i < objects_.size(); i++)
+    {
+        construct<1>(buffer,
+                     objects_[i].name,
+                     allocated[i],
+                     objects_[i].alignment);
+    }
+
+    // the allocation algorithm does not hand out the whole free memory it
+    // reports: the last allocation of a segment requires one more unit
+    return SEGMENT_HEADER_SIZE + buffer.get_size() - buffer.get_free_memory() +
+           MemoryAlgorithm::Alignment + counted + SAFETY_MARGIN;
+}
+
+}  // namespace internal
+
+}  // namespace shared_memory
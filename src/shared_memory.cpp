@@ -78,9 +78,29 @@ bool wait_for_segment(const std::string &segment_id, int timeout_ms)
  * Definition of the SharedMemorySegment class *
  ***********************************************/
 
+// size of the shared memory object, 0 if it does not exist
+static std::size_t shared_memory_size(const std::string &segment_id)
+{
+    try
+    {
+        bi::shared_memory_object shm(
+            bi::open_only, segment_id.c_str(), bi::read_only);
+        bi::offset_t size;
+        if (shm.get_size(size))
+        {
+            return static_cast<std::size_t>(size);
+        }
+    }
+    catch (const bi::interprocess_exception &)
+    {
+    }
+    return 0;
+}
+
 SharedMemorySegment::SharedMemorySegment(std::string segment_id,
                                          bool clear_upon_destruction,
-                                         bool create)
+                                         bool create,
+                                         bool huge_pages)
 {
     // save the id the of the segment
     segment_id_ = segment_id;
@@ -88,14 +108,24 @@ SharedMemorySegment::SharedMemorySegment(std::string segment_id,
     // check if we should delete the memory upon destruction.
     clear_upon_destruction_ = clear_upon_destruction;
 
+    growable_ = false;
+
+    huge_pages_ = huge_pages;
+    huge_pages_advised_ = false;
+
+    // the segment may only grow meanwhile, so the mapping created below
+    // is at least of this size (0 if the segment does not exist yet)
+    std::size_t size = shared_memory_size(segment_id);
+
     // create and/or map the memory segment
     SEGMENT_SIZE_MUTEX.lock();
+    std::size_t created_size = SEGMENT_SIZE;
     if (create)
     {
         segment_manager_ = boost::interprocess::managed_shared_memory(
             boost::interprocess::open_or_create,
             segment_id.c_str(),
-            SEGMENT_SIZE);
+            created_size);
     }
     else
     {
@@ -111,7 +141,24 @@ SharedMemorySegment::SharedMemorySegment(std::string segment_id,
         }
     }
     SEGMENT_SIZE_MUTEX.unlock();
+    advise_huge_pages();
     create_mutex();
+
+    // if the segment did not grow since it has been mapped (i.e. it is
+    // still of the size it had before, or it has just been created),
+    // the mapping covers the size recorded in the segment (which is
+    // updated only once the segment has grown), so that the first
+    // registration does not map the segment again
+    std::size_t recorded_size = segment_manager_.get_size();
+    std::size_t current_size = shared_memory_size(segment_id);
+    if (current_size == size || (size == 0 && current_size == created_size))
+    {
+        mapped_size_ = recorded_size;
+    }
+    else
+    {
+        mapped_size_ = size;
+    }
 }
 
 void SharedMemorySegment::clear_memory()
@@ -119,32 +166,256 @@ void SharedMemorySegment::clear_memory()
     boost::interprocess::shared_memory_object::remove(segment_id_.c_str());
 }
 
+void SharedMemorySegment::set_growable(bool growable)
+{
+    growable_ = growable;
+}
+
+void SharedMemorySegment::reserve(std::size_t free_bytes)
+{
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>
+        lock(*mutex_);
+    update_mapping();
+    std::size_t free_memory = segment_manager_.get_free_memory();
+    if (free_memory < free_bytes)
+    {
+        grow(free_bytes - free_memory);
+    }
+}
+
+void SharedMemorySegment::update_mapping()
+{
+    // segments grow only while their mutex is locked, i.e. not
+    // while this function runs. The size recorded in the segment is
+    // read from the current mapping, without a system call
+    std::size_t size = segment_manager_.get_size();
+    if (size <= mapped_size_)
+    {
+        return;
+    }
+    retired_segment_managers_.push_back(std::move(segment_manager_));
+    segment_manager_ = boost::interprocess::managed_shared_memory(
+        boost::interprocess::open_only, segment_id_.c_str());
+    mapped_size_ = size;
+    advise_huge_pages();
+}
+
+void SharedMemorySegment::advise_huge_pages()
+{
+    if (!huge_pages_)
+    {
+        return;
+    }
+    huge_pages_advised_ = internal::advise_huge_pages(segment_manager_);
+    if (!huge_pages_advised_ && VERBOSE)
+    {
+        std::cout << "shared_memory | huge pages not available for segment "
+                  << segment_id_ << std::endl;
+    }
+}
+
+void SharedMemorySegment::grow(std::size_t extra_bytes)
+{
+    // growing by at least the current size, so that a segment in which
+    // objects are added one by one is not grown at each addition
+    std::size_t size = shared_memory_size(segment_id_);
+    extra_bytes = std::max(extra_bytes, size);
+    if (!boost::interprocess::managed_shared_memory::grow(segment_id_.c_str(),
+                                                          extra_bytes))
+    {
+        throw boost::interprocess::bad_alloc();
+    }
+    update_mapping();
+}
+
+void SharedMemorySegment::register_header(const std::string &object_id)
+{
+    internal::ObjectHeader *header =
+        segment_manager_
+            .find<internal::ObjectHeader>(
+                internal::object_header_id(object_id).c_str())
+            .first;
+    if (header != nullptr)
+    {
+        headers_[object_id] = header;
+    }
+}
+
 void SharedMemorySegment::get_object(const std::string &object_id,
                                      std::string &get_)
 {
-    mutex_->lock();
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>
+        lock(*mutex_);
+
+    get_object_locked(object_id, get_);
+}
+
+void SharedMemorySegment::get_object_locked(const std::string &object_id,
+                                            std::string &get_)
+{
+    register_object_read_only<char>(object_id);
+
+    // resize and assign reuse the capacity of get_, i.e. do
+    // not allocate memory if get_ is already large enough
+    ShmHeaders::iterator header = headers_.find(object_id);
+    if (header != headers_.end())
+    {
+        get_.resize(objects_[object_id].second);
+        header->second->read(static_cast<const char *>(objects_[object_id].first),
+                             &get_[0],
+                             objects_[object_id].second);
+    }
+    else
+    {
+        get_.assign(static_cast<const char *>(objects_[object_id].first),
+                    objects_[object_id].second);
+    }
+}
+
+Batch SharedMemorySegment::begin_batch()
+{
+    return Batch(*this);
+}
+
+std::size_t SharedMemorySegment::get_object(const std::string &object_id,
+                                            char *get_,
+                                            std::size_t capacity)
+{
+    boost::interprocess::scoped_lock<boost::interprocess::interprocess_mutex>
+        lock(*mutex_);
 
     register_object_read_only<char>(object_id);
 
-    get_ = std::string(static_cast<char *>(objects_[object_id].first),
-                       objects_[object_id].second);
+    const char *shared_data =
+        static_cast<const char *>(objects_[object_id].first);
+    std::size_t size = objects_[object_id].second;
+    if (size > capacity)
+    {
+        throw shared_memory::Unexpected_size_exception(
+            segment_id_, object_id, size, capacity);
+    }
 
-    mutex_->unlock();
+    ShmHeaders::iterator header = headers_.find(object_id);
+    if (header != headers_.end())
+    {
+        header->second->read(shared_data, get_, size);
+    }
+    else
+    {
+        internal::copy(get_, shared_data, size);
+    }
+    return size;
 }
 
-SharedMemorySegment &get_segment(const std::string &segment_id,
-                                 const bool clear_upon_destruction,
-                                 const bool create)
+/**
+ * @brief SegmentRegistry is the process wide registry of the segments
+ * mapped by the current process. Segments are spread over shards, each
+ * protected by its own reader-writer lock, so that threads looking up
+ * segments already mapped do not block each other (and a thread mapping
+ * a new segment blocks only the lookups of its shard).
+ */
+class SegmentRegistry
 {
-    if (GLOBAL_SHM_SEGMENTS.count(segment_id) == 0)
+public:
+    SharedMemorySegment &get(const std::string &segment_id,
+                             bool clear_upon_destruction,
+                             bool create,
+                             bool huge_pages)
+    {
+        Shard &shard = get_shard(segment_id);
+        {
+            std::shared_lock<std::shared_mutex> lock(shard.mutex);
+            SegmentMap::const_iterator segment =
+                shard.segments.find(segment_id);
+            if (segment != shard.segments.end() &&
+                segment->second->get_clear_upon_destruction() ==
+                    clear_upon_destruction)
+            {
+                return *segment->second;
+            }
+        }
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        std::unique_ptr<SharedMemorySegment> &segment =
+            shard.segments[segment_id];
+        if (!segment)
+        {
+            try
+            {
+                segment.reset(new SharedMemorySegment(
+                    segment_id, clear_upon_destruction, create, huge_pages));
+            }
+            catch (...)
+            {
+                shard.segments.erase(segment_id);
+                throw;
+            }
+        }
+        segment->set_clear_upon_destruction(clear_upon_destruction);
+        return *segment;
+    }
+
+    bool exists(const std::string &segment_id)
     {
-        SharedMemorySegment *s =
-            new SharedMemorySegment(segment_id, clear_upon_destruction, create);
-        GLOBAL_SHM_SEGMENTS[segment_id].reset(s);
+        Shard &shard = get_shard(segment_id);
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        return shard.segments.count(segment_id) != 0;
     }
-    GLOBAL_SHM_SEGMENTS[segment_id]->set_clear_upon_destruction(
-        clear_upon_destruction);
-    return *GLOBAL_SHM_SEGMENTS[segment_id];
+
+    void erase(const std::string &segment_id)
+    {
+        Shard &shard = get_shard(segment_id);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        // here the unique pointer destroy the object for us.
+        shard.segments.erase(segment_id);
+    }
+
+    void clear()
+    {
+        for (Shard &shard : shards_)
+        {
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            for (SegmentMap::iterator seg_it = shard.segments.begin();
+                 seg_it != shard.segments.end();
+                 seg_it = shard.segments.begin())
+            {
+                seg_it->second->set_clear_upon_destruction(true);
+                shard.segments.erase(seg_it);
+            }
+        }
+    }
+
+private:
+    static const std::size_t NB_SHARDS = 16;
+
+    struct Shard
+    {
+        std::shared_mutex mutex;
+        SegmentMap segments;
+    };
+
+    Shard &get_shard(const std::string &segment_id)
+    {
+        return shards_[std::hash<std::string>()(segment_id) % NB_SHARDS];
+    }
+
+    Shard shards_[NB_SHARDS];
+};
+
+// constructed at first use, so that segments can be used
+// during the static initialization of other translation units
+static SegmentRegistry &segment_registry()
+{
+    static SegmentRegistry registry;
+    return registry;
+}
+
+SharedMemorySegment &get_segment(const std::string &segment_id,
+                                 const bool clear_upon_destruction,
+                                 const bool create,
+                                 const bool huge_pages)
+{
+    return segment_registry().get(
+        segment_id, clear_upon_destruction, create, huge_pages);
 }
 
 SegmentInfo get_segment_info(const std::string &segment_id)
@@ -156,11 +427,7 @@ SegmentInfo get_segment_info(const std::string &segment_id)
 
 bool segment_exists(const std::string &segment_id)
 {
-    if (GLOBAL_SHM_SEGMENTS.count(segment_id) == 0)
-    {
-        return false;
-    }
-    return true;
+    return segment_registry().exists(segment_id);
 }
 
 boost::interprocess::interprocess_mutex &get_segment_mutex(
@@ -172,8 +439,7 @@ boost::interprocess::interprocess_mutex &get_segment_mutex(
 
 void delete_segment(const std::string &segment_id)
 {
-    // here the unique pointer destroy the object for us.
-    GLOBAL_SHM_SEGMENTS.erase(segment_id);
+    segment_registry().erase(segment_id);
 }
 
 void delete_all_segment()
@@ -183,13 +449,7 @@ void delete_all_segment()
 
 void delete_all_segments()
 {
-    for (SegmentMap::iterator seg_it = GLOBAL_SHM_SEGMENTS.begin();
-         seg_it != GLOBAL_SHM_SEGMENTS.end();
-         seg_it = GLOBAL_SHM_SEGMENTS.begin())
-    {
-        get_segment(seg_it->second->get_segment_id(), true);
-        GLOBAL_SHM_SEGMENTS.erase(seg_it);
-    }
+    segment_registry().clear();
 }
 
 void clear_shared_memory(const std::string &segment_id)
@@ -198,6 +458,29 @@ void clear_shared_memory(const std::string &segment_id)
     delete_segment(segment_id);
 }
 
+void set_segment_growable(const std::string &segment_id, bool growable)
+{
+    get_segment(segment_id).set_growable(growable);
+}
+
+void reserve_segment_memory(const std::string &segment_id,
+                            std::size_t free_bytes)
+{
+    try
+    {
+        get_segment(segment_id).reserve(free_bytes);
+    }
+    catch (const boost::interprocess::bad_alloc &)
+    {
+        throw shared_memory::Allocation_exception(segment_id, "");
+    }
+}
+
+Batch begin_batch(const std::string &segment_id, bool create)
+{
+    return get_segment(segment_id, false, create).begin_batch();
+}
+
 /***********************************
  * Definition of all set functions *
  ***********************************/
@@ -233,4 +516,27 @@ void get(const std::string &segment_id,
     }
 }
 
+void get(const std::string &segment_id,
+         const std::string &object_id,
+         char *get_,
+         std::size_t capacity,
+         std::size_t &size,
+         bool create)
+{
+    size = 0;
+    try
+    {
+        SharedMemorySegment &segment = get_segment(segment_id, false, create);
+        size = segment.get_object(object_id, get_, capacity);
+    }
+    catch (const boost::interprocess::bad_alloc &)
+    {
+        throw shared_memory::Allocation_exception(segment_id, object_id);
+    }
+    catch (const boost::interprocess::interprocess_exception &)
+    {
+        return;
+    }
+}
+
 }  // namespace shared_memory
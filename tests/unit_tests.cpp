@@ -11,7 +11,10 @@
 
 #include <unistd.h>
 
+#include <atomic>
 #include <cstdlib>
+#include <fstream>
+#include <numeric>
 #include <sstream>
 #include <thread>
 
@@ -20,12 +23,16 @@
 #include "shared_memory/condition_variable.hpp"
 #include "shared_memory/demos/four_int_values.hpp"
 #include "shared_memory/demos/item.hpp"
+#include "shared_memory/exchange_manager_broadcast_consumer.hpp"
+#include "shared_memory/exchange_manager_broadcast_producer.hpp"
 #include "shared_memory/exchange_manager_consumer.hpp"
 #include "shared_memory/exchange_manager_producer.hpp"
 #include "shared_memory/lock.hpp"
 #include "shared_memory/locked_condition_variable.hpp"
 #include "shared_memory/mutex.hpp"
+#include "shared_memory/ring_buffer.hpp"
 #include "shared_memory/shared_memory.hpp"
+#include "shared_memory/static_array.hpp"
 #include "shared_memory/tests/tests.h"
 
 // set in the CMakeLists.txt file
@@ -718,6 +725,25 @@ TEST_F(SharedMemoryTests, exchange_manager)
 
         ASSERT_EQ(failed_to_produce_all, false);
 
+        // the loop above may end as soon as all the feedbacks are
+        // received, i.e. before the consumer exited. Waiting for it to
+        // exit (and for the producer to reset the memory): a consumer
+        // started meanwhile would attach to the memory about to be
+        // reset, and would never be served
+        waited = 0;
+        bool failed_to_stop = false;
+        while (producer.ready_to_produce())
+        {
+            usleep(100);
+            waited += 100;
+            if (waited > max_wait)
+            {
+                failed_to_stop = true;
+                break;
+            }
+        }
+        ASSERT_EQ(failed_to_stop, false);
+
         bool command_failed;
         shared_memory::get<bool>(
             shared_memory_test::exchange_manager_segment_id,
@@ -764,6 +790,288 @@ TEST_F(SharedMemoryTests, exchange_manager_init)
     ASSERT_EQ(consumed, false);
 }
 
+TEST_F(SharedMemoryTests, exchange_manager_batch)
+{
+    typedef shared_memory::Exchange_manager_producer<
+        shared_memory::Four_int_values,
+        DATA_EXCHANGE_QUEUE_SIZE>
+        Producer;
+
+    typedef shared_memory::Exchange_manager_consumer<
+        shared_memory::Four_int_values,
+        DATA_EXCHANGE_QUEUE_SIZE>
+        Consumer;
+
+    Producer::clean_mutex(shared_memory_test::segment_id);
+    Producer::clean_memory(shared_memory_test::segment_id);
+
+    Producer producer(
+        shared_memory_test::segment_id, shared_memory_test::object_id, true);
+    Consumer consumer(
+        shared_memory_test::segment_id, shared_memory_test::object_id, false);
+
+    std::vector<shared_memory::Four_int_values> in;
+    for (int i = 0; i < 10; i++)
+    {
+        in.push_back(shared_memory::Four_int_values(i, i + 1, i + 2, i + 3));
+    }
+    ASSERT_TRUE(producer.set_batch(in));
+
+    shared_memory::Four_int_values first[4];
+    ASSERT_EQ(consumer.consume_batch(first, 4), 4);
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(first[i].same(in[i]));
+    }
+
+    std::vector<shared_memory::Four_int_values> out;
+    ASSERT_EQ(consumer.consume_batch(out, 100), 6);
+    ASSERT_EQ(out.size(), 6);
+    for (int i = 0; i < 6; i++)
+    {
+        ASSERT_TRUE(out[i].same(in[i + 4]));
+    }
+    ASSERT_EQ(consumer.consume_batch(out, 100), 0);
+    ASSERT_EQ(out.size(), 6);
+
+    // feedback of all the consumed items, in order
+    std::deque<int> consumed_ids;
+    producer.get(consumed_ids);
+    ASSERT_EQ(consumed_ids.size(), in.size());
+    for (std::size_t i = 0; i < in.size(); i++)
+    {
+        ASSERT_EQ(consumed_ids[i], in[i].get_id());
+    }
+
+    // more items than the queue can hold: the remaining ones are
+    // buffered by the producer, and shared once the queue has room
+    std::vector<shared_memory::Four_int_values> many(
+        DATA_EXCHANGE_QUEUE_SIZE, shared_memory::Four_int_values(1, 2, 3, 4));
+    ASSERT_FALSE(producer.set_batch(many));
+    std::size_t nb_consumed = 0;
+    bool everything_shared = false;
+    while (!everything_shared)
+    {
+        std::size_t nb_read = consumer.consume_batch(out, 100);
+        ASSERT_GT(nb_read, 0);
+        nb_consumed += nb_read;
+        everything_shared = producer.set_batch(nullptr, 0);
+    }
+    nb_consumed += consumer.consume_batch(out, many.size());
+    ASSERT_EQ(nb_consumed, many.size());
+}
+
+TEST_F(SharedMemoryTests, exchange_manager_wait)
+{
+    typedef shared_memory::Exchange_manager_producer<
+        shared_memory::Four_int_values,
+        DATA_EXCHANGE_QUEUE_SIZE>
+        Producer;
+
+    typedef shared_memory::Exchange_manager_consumer<
+        shared_memory::Four_int_values,
+        DATA_EXCHANGE_QUEUE_SIZE>
+        Consumer;
+
+    Producer::clean_mutex(shared_memory_test::segment_id);
+    Producer::clean_memory(shared_memory_test::segment_id);
+
+    Producer producer(
+        shared_memory_test::segment_id, shared_memory_test::object_id, true);
+    Consumer consumer(
+        shared_memory_test::segment_id, shared_memory_test::object_id, false);
+
+    long timeout = 5e9;
+
+    // nothing to wait for
+    ASSERT_FALSE(consumer.wait_for_items(1e6));
+    ASSERT_FALSE(producer.wait_for_feedback(1e6));
+
+    // consumer woken up by the producer
+    std::vector<shared_memory::Four_int_values> in(
+        3, shared_memory::Four_int_values(1, 2, 3, 4));
+    std::thread producing([&producer, &in]() {
+        usleep(20000);
+        producer.set_batch(in);
+    });
+    ASSERT_TRUE(consumer.wait_for_items(timeout));
+    producing.join();
+    std::vector<shared_memory::Four_int_values> out;
+    ASSERT_EQ(consumer.consume_batch(out, 10), 3);
+    ASSERT_FALSE(consumer.wait_for_items(1e6));
+
+    // feedback not read yet
+    ASSERT_TRUE(producer.wait_for_feedback(timeout));
+    std::deque<int> consumed_ids;
+    producer.get(consumed_ids);
+    ASSERT_EQ(consumed_ids.size(), 3);
+    ASSERT_FALSE(producer.wait_for_feedback(1e6));
+
+    // producer woken up by the consumer
+    std::thread consuming([&consumer, timeout]() {
+        shared_memory::Four_int_values item;
+        if (consumer.wait_for_items(timeout))
+        {
+            consumer.consume(item);
+        }
+    });
+    usleep(20000);
+    producer.set(shared_memory::Four_int_values(5, 6, 7, 8));
+    ASSERT_TRUE(producer.wait_for_feedback(timeout));
+    consuming.join();
+    consumed_ids.clear();
+    producer.get(consumed_ids);
+    ASSERT_EQ(consumed_ids.size(), 1);
+}
+
+TEST_F(SharedMemoryTests, exchange_manager_broadcast)
+{
+    typedef shared_memory::Exchange_manager_broadcast_producer<
+        shared_memory::Four_int_values,
+        DATA_EXCHANGE_QUEUE_SIZE,
+        3>
+        Producer;
+
+    typedef shared_memory::Exchange_manager_broadcast_consumer<
+        shared_memory::Four_int_values,
+        DATA_EXCHANGE_QUEUE_SIZE,
+        3>
+        Consumer;
+
+    Producer::clean_mutex(shared_memory_test::segment_id);
+    Producer::clean_memory(shared_memory_test::segment_id);
+
+    Producer producer(shared_memory_test::segment_id,
+                      shared_memory_test::object_id);
+    Consumer consumer0(
+        shared_memory_test::segment_id, shared_memory_test::object_id, 0);
+    std::unique_ptr<Consumer> consumer1(new Consumer(
+        shared_memory_test::segment_id, shared_memory_test::object_id, 1));
+    ASSERT_EQ(producer.nb_consumers(), 2);
+
+    ASSERT_THROW(
+        Consumer(
+            shared_memory_test::segment_id, shared_memory_test::object_id, 1),
+        std::runtime_error);
+    ASSERT_THROW(
+        Consumer(
+            shared_memory_test::segment_id, shared_memory_test::object_id, 3),
+        std::runtime_error);
+
+    // each consumer reads all the items
+    std::vector<shared_memory::Four_int_values> in;
+    for (int i = 0; i < 5; i++)
+    {
+        in.push_back(shared_memory::Four_int_values(i, i, i, i));
+    }
+    ASSERT_TRUE(producer.set_batch(in));
+    std::vector<shared_memory::Four_int_values> out0;
+    std::vector<shared_memory::Four_int_values> out1;
+    ASSERT_TRUE(consumer1->wait_for_items(1e9));
+    ASSERT_EQ(consumer0.consume_batch(out0, 10), 5);
+    ASSERT_EQ(consumer1->consume_batch(out1, 10), 5);
+    for (int i = 0; i < 5; i++)
+    {
+        ASSERT_TRUE(out0[i].same(in[i]));
+        ASSERT_TRUE(out1[i].same(in[i]));
+    }
+
+    // feedback per consumer
+    std::deque<int> consumed_ids;
+    producer.get(0, consumed_ids);
+    ASSERT_EQ(consumed_ids.size(), 5);
+    consumed_ids.clear();
+    producer.get(1, consumed_ids);
+    ASSERT_EQ(consumed_ids.size(), 5);
+    ASSERT_EQ(consumed_ids.back(), in.back().get_id());
+    consumed_ids.clear();
+    producer.get(2, consumed_ids);
+    ASSERT_EQ(consumed_ids.size(), 0);
+
+    // consumer 1 does not consume: the producer can not write more
+    // than the capacity
+    shared_memory::Four_int_values item(1, 2, 3, 4);
+    shared_memory::Four_int_values read;
+    for (std::size_t i = 0; i < producer.capacity(); i++)
+    {
+        ASSERT_TRUE(producer.set(item));
+        ASSERT_TRUE(consumer0.consume(read));
+    }
+    ASSERT_FALSE(producer.set(item));
+    ASSERT_FALSE(consumer0.consume(read));
+    std::vector<int> slow_consumers;
+    producer.get_slow_consumers(producer.capacity(), slow_consumers);
+    ASSERT_EQ(slow_consumers, std::vector<int>{1});
+
+    // ... until dropped
+    producer.drop_consumer(1);
+    ASSERT_FALSE(consumer1->attached());
+    ASSERT_FALSE(consumer1->consume(read));
+    ASSERT_TRUE(producer.set(item));
+    ASSERT_EQ(consumer0.consume_batch(out0, 10), 2);
+    ASSERT_EQ(producer.nb_consumers(), 1);
+
+    // the index of the dropped consumer can be used again
+    consumer1.reset(new Consumer(
+        shared_memory_test::segment_id, shared_memory_test::object_id, 1));
+    ASSERT_TRUE(consumer1->attached());
+    ASSERT_FALSE(consumer1->consume(read));
+    ASSERT_TRUE(producer.set(item));
+    ASSERT_TRUE(consumer1->consume(read));
+    ASSERT_TRUE(consumer0.consume(read));
+}
+
+TEST_F(SharedMemoryTests, exchange_manager_broadcast_drop_slow_consumers)
+{
+    typedef shared_memory::Exchange_manager_broadcast_producer<
+        shared_memory::Four_int_values,
+        DATA_EXCHANGE_QUEUE_SIZE,
+        2>
+        Producer;
+
+    typedef shared_memory::Exchange_manager_broadcast_consumer<
+        shared_memory::Four_int_values,
+        DATA_EXCHANGE_QUEUE_SIZE,
+        2>
+        Consumer;
+
+    Producer::clean_mutex(shared_memory_test::segment_id);
+    Producer::clean_memory(shared_memory_test::segment_id);
+
+    bool drop_slow_consumers = true;
+    Producer producer(shared_memory_test::segment_id,
+                      shared_memory_test::object_id,
+                      drop_slow_consumers);
+    Consumer fast(
+        shared_memory_test::segment_id, shared_memory_test::object_id, 0);
+    Consumer slow(
+        shared_memory_test::segment_id, shared_memory_test::object_id, 1);
+
+    // the producer never waits for the slow consumer
+    shared_memory::Four_int_values item(1, 2, 3, 4);
+    shared_memory::Four_int_values read;
+    ASSERT_TRUE(producer.set(item));
+    ASSERT_TRUE(fast.consume(read));
+    ASSERT_TRUE(slow.consume(read));
+    for (std::size_t i = 0; i < 3 * producer.capacity(); i++)
+    {
+        ASSERT_TRUE(producer.set(item));
+        ASSERT_TRUE(fast.consume(read));
+    }
+    ASSERT_TRUE(fast.attached());
+    ASSERT_FALSE(slow.attached());
+    ASSERT_FALSE(slow.consume(read));
+    ASSERT_TRUE(slow.purge_feedbacks());
+
+    // the ids consumed before the drop are not reported to the
+    // producer as consumed by the next consumer with this index
+    Consumer next(
+        shared_memory_test::segment_id, shared_memory_test::object_id, 1);
+    std::deque<int> consumed_ids;
+    producer.get(1, consumed_ids);
+    ASSERT_EQ(consumed_ids.size(), 0);
+}
+
 TEST_F(SharedMemoryTests, serialization)
 {
     shared_memory::clear_shared_memory("test_ser");
@@ -800,6 +1108,26 @@ TEST_F(SharedMemoryTests, serialization2)
     }
 }
 
+TEST_F(SharedMemoryTests, serialization_in_place)
+{
+    shared_memory::Serializer<shared_memory::Four_int_values> serializer;
+    std::size_t size =
+        shared_memory::Serializer<shared_memory::Four_int_values>::
+            serializable_size();
+
+    shared_memory::Four_int_values in(1, 2, 3, 4);
+    std::vector<char> buffer(size);
+    ASSERT_EQ(serializer.serialize(in, buffer.data(), size), size);
+    ASSERT_EQ(std::string(buffer.data(), size), serializer.serialize(in));
+
+    shared_memory::Four_int_values out;
+    serializer.deserialize(buffer.data(), size, out);
+    ASSERT_TRUE(in.same(out));
+
+    ASSERT_THROW(serializer.serialize(in, buffer.data(), size - 1),
+                 std::runtime_error);
+}
+
 static shared_memory::array<int> get_array_int()
 {
     shared_memory::array<int> a("test_array", 10, true, true);
@@ -885,29 +1213,47 @@ TEST_F(SharedMemoryTests, array_array_int)
     }
 }
 
+// not trivially copyable, stored serialized by arrays
+class SerializedItem : public shared_memory::Item<10>
+{
+public:
+    SerializedItem()
+    {
+    }
+    SerializedItem(int value) : shared_memory::Item<10>(value)
+    {
+    }
+    SerializedItem(const SerializedItem& other)
+        : shared_memory::Item<10>(other)
+    {
+    }
+    SerializedItem& operator=(const SerializedItem& other) = default;
+};
+static_assert(!std::is_trivially_copyable<SerializedItem>::value,
+              "SerializedItem should be stored serialized");
+
 TEST_F(SharedMemoryTests, array_serializable)
 {
     shared_memory::clear_array("test_array");
 
     int size = 100;
 
-    shared_memory::array<shared_memory::Item<10>> a(
-        "test_array", size, true, true);
+    shared_memory::array<SerializedItem> a("test_array", size, true, true);
 
     for (int i = 0; i < size; i++)
     {
-        shared_memory::Item<10> item(i);
+        SerializedItem item(i);
         a.set(i, item);
     }
 
-    shared_memory::Item<10> item;
+    SerializedItem item;
     for (int i = 0; i < size; i++)
     {
         a.get(i, item);
         ASSERT_EQ(item.get(), i);
     }
 
-    shared_memory::array<shared_memory::Item<10>> b(a);
+    shared_memory::array<SerializedItem> b(a);
     for (int i = 0; i < size; i++)
     {
         b.get(i, item);
@@ -921,22 +1267,21 @@ TEST_F(SharedMemoryTests, array_serializable_get_serializable)
 
     int size = 100;
 
-    shared_memory::array<shared_memory::Item<10>> a(
-        "test_array", size, true, true);
+    shared_memory::array<SerializedItem> a("test_array", size, true, true);
 
     for (int i = 0; i < size; i++)
     {
-        shared_memory::Item<10> item(i);
+        SerializedItem item(i);
         a.set(i, item);
     }
 
-    shared_memory::Item<10> item;
-    shared_memory::Serializer<shared_memory::Item<10>> serializer;
+    SerializedItem item;
+    shared_memory::Serializer<SerializedItem> serializer;
     for (int i = 0; i < size; i++)
     {
         a.get(i, item);
         std::string item_serialized = a.get_serialized(i);
-        shared_memory::Item<10> item2;
+        SerializedItem item2;
         serializer.deserialize(item_serialized, item2);
         ASSERT_EQ(item.get(), item2.get());
     }
@@ -1012,3 +1357,1218 @@ TEST_F(SharedMemoryTests, segment_info)
     }
     ASSERT_TRUE(exception);
 }
+
+TEST_F(SharedMemoryTests, seqlock)
+{
+    shared_memory::clear_shared_memory("test_seqlock");
+
+    int size = 100;
+    shared_memory::create_object<double>(
+        "test_seqlock", "values", size, shared_memory::SEQLOCK);
+
+    std::vector<double> written(size, 0.);
+    shared_memory::set("test_seqlock", "values", written);
+
+    // readers should never see values written by different writes
+    std::thread writer([size]() {
+        std::vector<double> values(size);
+        for (int iteration = 1; iteration < 10000; iteration++)
+        {
+            std::fill(values.begin(), values.end(), iteration);
+            shared_memory::set("test_seqlock", "values", values);
+        }
+    });
+
+    std::vector<double> read(size);
+    for (int iteration = 0; iteration < 10000; iteration++)
+    {
+        shared_memory::get("test_seqlock", "values", read);
+        for (int i = 1; i < size; i++)
+        {
+            ASSERT_EQ(read[i], read[0]);
+        }
+    }
+    writer.join();
+
+    shared_memory::get("test_seqlock", "values", read);
+    ASSERT_EQ(read[0], 9999.);
+
+    shared_memory::clear_shared_memory("test_seqlock");
+}
+
+TEST_F(SharedMemoryTests, object_handle)
+{
+    shared_memory::clear_shared_memory("test_handle");
+
+    shared_memory::ObjectHandle<double> value =
+        shared_memory::get_handle<double>("test_handle", "value");
+    double d;
+    value.set(5.0);
+    shared_memory::get("test_handle", "value", d);
+    ASSERT_EQ(d, 5.0);
+    shared_memory::set("test_handle", "value", 6.0);
+    value.get(d);
+    ASSERT_EQ(d, 6.0);
+
+    shared_memory::ObjectHandle<double> values =
+        shared_memory::get_handle<double>(
+            "test_handle", "values", shared_memory_test::test_array_size);
+    ASSERT_EQ(values.size(), shared_memory_test::test_array_size);
+    values.set(shared_memory_test::test_array,
+               shared_memory_test::test_array_size);
+    std::vector<double> v(shared_memory_test::test_array_size);
+    values.get(v);
+    for (unsigned int i = 0; i < shared_memory_test::test_array_size; i++)
+    {
+        ASSERT_EQ(v[i], shared_memory_test::test_array[i]);
+    }
+
+    std::vector<double> wrong_size(shared_memory_test::test_array_size + 1);
+    ASSERT_THROW(values.get(wrong_size),
+                 shared_memory::Unexpected_size_exception);
+    ASSERT_THROW(shared_memory::get_handle<double>("test_handle", "value", 2),
+                 shared_memory::Unexpected_size_exception);
+
+    // objects registered for the first time (here by another mapping of
+    // the segment, as another process would) are checked against the
+    // size they have been created with
+    shared_memory::SharedMemorySegment other("test_handle", false, false);
+    ASSERT_THROW(other.get_handle<double>(
+                     "values", shared_memory_test::test_array_size + 1),
+                 shared_memory::Unexpected_size_exception);
+    ASSERT_EQ(other.get_handle<double>("values",
+                                       shared_memory_test::test_array_size)
+                  .size(),
+              shared_memory_test::test_array_size);
+
+    shared_memory::clear_shared_memory("test_handle");
+}
+
+TEST_F(SharedMemoryTests, object_mutex)
+{
+    shared_memory::clear_shared_memory("test_object_mutex");
+
+    shared_memory::create_object<double>(
+        "test_object_mutex", "a", 1, shared_memory::OBJECT_MUTEX);
+    shared_memory::create_object<double>(
+        "test_object_mutex", "b", 1, shared_memory::OBJECT_MUTEX);
+    shared_memory::set("test_object_mutex", "a", 1.0);
+    shared_memory::set("test_object_mutex", "b", 2.0);
+
+    // once registered, the objects are accessed without locking
+    // the segment mutex
+    boost::interprocess::interprocess_mutex& segment_mutex =
+        shared_memory::get_segment_mutex("test_object_mutex");
+    segment_mutex.lock();
+    double a, b;
+    shared_memory::set("test_object_mutex", "a", 3.0);
+    shared_memory::get("test_object_mutex", "a", a);
+    shared_memory::get("test_object_mutex", "b", b);
+    segment_mutex.unlock();
+    ASSERT_EQ(a, 3.0);
+    ASSERT_EQ(b, 2.0);
+
+    // values written by another thread are read in order
+    shared_memory::set("test_object_mutex", "a", 0.0);
+    std::thread writer([]() {
+        for (int iteration = 1; iteration < 10000; iteration++)
+        {
+            shared_memory::set("test_object_mutex", "a", double(iteration));
+        }
+    });
+    double previous = 0;
+    for (int iteration = 0; iteration < 10000; iteration++)
+    {
+        shared_memory::get("test_object_mutex", "a", a);
+        ASSERT_GE(a, previous);
+        previous = a;
+    }
+    writer.join();
+    shared_memory::get("test_object_mutex", "a", a);
+    ASSERT_EQ(a, 9999.0);
+
+    shared_memory::clear_shared_memory("test_object_mutex");
+}
+
+TEST_F(SharedMemoryTests, read_view)
+{
+    shared_memory::clear_shared_memory("test_read_view");
+
+    std::vector<double> values(shared_memory_test::test_array,
+                               shared_memory_test::test_array +
+                                   shared_memory_test::test_array_size);
+    shared_memory::set("test_read_view", "values", values);
+
+    {
+        shared_memory::ReadView<double> view =
+            shared_memory::get_read_view<double>(
+                "test_read_view", "values", values.size());
+        ASSERT_EQ(view.size(), values.size());
+        for (unsigned int i = 0; i < values.size(); i++)
+        {
+            ASSERT_EQ(view[i], values[i]);
+        }
+        ASSERT_EQ(view.eigen().sum(),
+                  std::accumulate(values.begin(), values.end(), 0.));
+
+        // writers are locked out while the view exists
+        ASSERT_FALSE(
+            shared_memory::get_segment_mutex("test_read_view").try_lock());
+    }
+    ASSERT_TRUE(shared_memory::get_segment_mutex("test_read_view").try_lock());
+    shared_memory::get_segment_mutex("test_read_view").unlock();
+
+    std::string s("read view");
+    shared_memory::set("test_read_view", "string", s);
+    {
+        shared_memory::ReadView<char> view = shared_memory::get_read_view<char>(
+            "test_read_view", "string", s.size());
+        ASSERT_EQ(std::string(view.begin(), view.end()), s);
+    }
+
+    // objects created with another policy lock their own mutex
+    shared_memory::create_object<int>(
+        "test_read_view", "object_mutex", 2, shared_memory::OBJECT_MUTEX);
+    {
+        shared_memory::ReadView<int> view = shared_memory::get_read_view<int>(
+            "test_read_view", "object_mutex", 2);
+        shared_memory::set("test_read_view", "other", 1);
+    }
+
+    // views of SEQLOCK objects do not lock out writers, but are
+    // invalidated by their writes
+    shared_memory::create_object<double>(
+        "test_read_view", "seqlock", 2, shared_memory::SEQLOCK);
+    {
+        shared_memory::ReadView<double> view =
+            shared_memory::get_read_view<double>(
+                "test_read_view", "seqlock", 2);
+        ASSERT_TRUE(view.valid());
+        double written[2] = {1.0, 2.0};
+        shared_memory::set("test_read_view", "seqlock", written, 2);
+        ASSERT_FALSE(view.valid());
+        view.retry();
+        ASSERT_TRUE(view.valid());
+        ASSERT_EQ(view[0] + view[1], 3.0);
+    }
+
+    ASSERT_THROW(shared_memory::get_read_view<double>(
+                     "test_read_view", "values", values.size() + 1),
+                 shared_memory::Unexpected_size_exception);
+    ASSERT_THROW(shared_memory::get_read_view<double>(
+                     "test_read_view", "not_existing", 1),
+                 shared_memory::Unexpected_size_exception);
+
+    shared_memory::clear_shared_memory("test_read_view");
+}
+
+TEST_F(SharedMemoryTests, get_string_into_buffer)
+{
+    shared_memory::clear_shared_memory("test_string_buffer");
+
+    std::string s("a string longer than the small string buffer");
+    shared_memory::set("test_string_buffer", "s", s);
+
+    char buffer[100];
+    std::size_t size;
+    shared_memory::get("test_string_buffer", "s", buffer, 100, size);
+    ASSERT_EQ(std::string(buffer, size), s);
+
+    ASSERT_THROW(shared_memory::get("test_string_buffer", "s", buffer, 5, size),
+                 shared_memory::Unexpected_size_exception);
+
+    shared_memory::Four_int_values fiv(1, 2, 3, 4);
+    shared_memory::serialize("test_string_buffer", "fiv", fiv);
+    shared_memory::get("test_string_buffer", "fiv", buffer, 100, size);
+    shared_memory::Serializer<shared_memory::Four_int_values> serializer;
+    shared_memory::Four_int_values read;
+    serializer.deserialize(buffer, size, read);
+    ASSERT_TRUE(read.equal(fiv));
+
+    shared_memory::clear_shared_memory("test_string_buffer");
+}
+
+TEST_F(SharedMemoryTests, batch)
+{
+    shared_memory::clear_shared_memory("test_batch");
+
+    shared_memory::Batch batch = shared_memory::begin_batch("test_batch");
+    int a = 1;
+    std::vector<double> v(3, 2.0);
+    std::string s("batch");
+    batch.set("a", a);
+    batch.set("v", v);
+    batch.set("s", s);
+    ASSERT_EQ(batch.size(), 3);
+    batch.commit();
+    ASSERT_EQ(batch.size(), 0);
+
+    int a_read;
+    std::vector<double> v_read(3);
+    std::string s_read;
+    batch.get("a", a_read);
+    batch.get("v", v_read);
+    batch.get("s", s_read);
+    batch.commit();
+    ASSERT_EQ(a_read, a);
+    ASSERT_EQ(v_read, v);
+    ASSERT_EQ(s_read, s);
+
+    // readers never observe a batch partially applied
+    shared_memory::set("test_batch", "first", 0);
+    shared_memory::set("test_batch", "second", 0);
+    std::thread writer([]() {
+        shared_memory::Batch batch = shared_memory::begin_batch("test_batch");
+        for (int iteration = 0; iteration < 10000; iteration++)
+        {
+            batch.set("first", iteration);
+            batch.set("second", iteration);
+            batch.commit();
+        }
+    });
+    int first, second;
+    for (int iteration = 0; iteration < 10000; iteration++)
+    {
+        batch.get("first", first);
+        batch.get("second", second);
+        batch.commit();
+        ASSERT_EQ(first, second);
+    }
+    writer.join();
+
+    std::vector<double> wrong_size(4);
+    batch.get("v", wrong_size);
+    ASSERT_THROW(batch.commit(), shared_memory::Unexpected_size_exception);
+    ASSERT_EQ(batch.size(), 0);
+
+    shared_memory::clear_shared_memory("test_batch");
+}
+
+TEST_F(SharedMemoryTests, concurrent_segments)
+{
+    int nb_threads = 8;
+    for (int thread = 0; thread < nb_threads; thread++)
+    {
+        shared_memory::clear_shared_memory("test_concurrent_" +
+                                           std::to_string(thread));
+    }
+    shared_memory::clear_shared_memory("test_concurrent_shared");
+    shared_memory::create_object<int>(
+        "test_concurrent_shared", "value", 1, shared_memory::OBJECT_MUTEX);
+
+    // threads of the same process using (and mapping) segments in parallel
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < nb_threads; thread++)
+    {
+        threads.push_back(std::thread([thread]() {
+            std::string segment = "test_concurrent_" + std::to_string(thread);
+            for (int iteration = 0; iteration < 1000; iteration++)
+            {
+                int value;
+                shared_memory::set(segment, "value", iteration);
+                shared_memory::get(segment, "value", value);
+                ASSERT_EQ(value, iteration);
+                shared_memory::set("test_concurrent_shared",
+                                   "object_" + std::to_string(iteration % 10),
+                                   iteration);
+                shared_memory::set("test_concurrent_shared", "value", value);
+                ASSERT_TRUE(shared_memory::segment_exists(segment));
+            }
+        }));
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (int thread = 0; thread < nb_threads; thread++)
+    {
+        int value;
+        shared_memory::get(
+            "test_concurrent_" + std::to_string(thread), "value", value);
+        ASSERT_EQ(value, 999);
+        shared_memory::clear_shared_memory("test_concurrent_" +
+                                           std::to_string(thread));
+    }
+    shared_memory::clear_shared_memory("test_concurrent_shared");
+}
+
+TEST_F(SharedMemoryTests, growable_segment)
+{
+    shared_memory::clear_shared_memory("test_growable");
+
+    shared_memory::set("test_growable", "small", 1);
+
+    // another mapping of the segment, as another process would have
+    shared_memory::SharedMemorySegment other("test_growable", false, false);
+
+    std::vector<int> large(DEFAULT_SHARED_MEMORY_SIZE / sizeof(int) + 1, 3);
+    ASSERT_THROW(shared_memory::set("test_growable", "large", large),
+                 shared_memory::Allocation_exception);
+
+    shared_memory::set_segment_growable("test_growable", true);
+    shared_memory::set("test_growable", "large", large);
+
+    std::vector<int> read(large.size(), 0);
+    shared_memory::get("test_growable", "large", read);
+    ASSERT_EQ(read, large);
+
+    // the other mapping maps the segment again before reading
+    // the new object
+    std::fill(read.begin(), read.end(), 0);
+    std::pair<int*, std::size_t> read_ref(read.data(), read.size());
+    other.get_object<int>("large", read_ref);
+    ASSERT_EQ(read, large);
+    int small = 0;
+    std::pair<int*, std::size_t> small_ref(&small, 1);
+    other.get_object<int>("small", small_ref);
+    ASSERT_EQ(small, 1);
+
+    shared_memory::reserve_segment_memory("test_growable", 1000000);
+    ASSERT_GE(shared_memory::get_segment_info("test_growable").get_free_memory(),
+              1000000);
+    ASSERT_GE(other.get_info().get_free_memory(), 1000000);
+
+    shared_memory::clear_shared_memory("test_growable");
+}
+
+static bool transparent_huge_pages_enabled()
+{
+    std::ifstream enabled("/sys/kernel/mm/transparent_hugepage/enabled");
+    std::string modes;
+    if (!std::getline(enabled, modes))
+    {
+        return false;
+    }
+    return modes.find("[never]") == std::string::npos;
+}
+
+TEST_F(SharedMemoryTests, huge_pages)
+{
+    // the kernel accepts the advice if it supports transparent huge
+    // pages (whether /dev/shm is mounted with huge pages enabled or not)
+    if (!transparent_huge_pages_enabled())
+    {
+        GTEST_SKIP() << "transparent huge pages not enabled";
+    }
+
+    shared_memory::clear_shared_memory("test_huge_pages");
+    shared_memory::SharedMemorySegment& segment =
+        shared_memory::get_segment("test_huge_pages", false, true, true);
+    ASSERT_TRUE(segment.get_huge_pages());
+    shared_memory::set("test_huge_pages", "value", 2.0);
+    double value;
+    shared_memory::get("test_huge_pages", "value", value);
+    ASSERT_EQ(value, 2.0);
+    shared_memory::delete_segment("test_huge_pages");
+    shared_memory::clear_shared_memory("test_huge_pages");
+
+    shared_memory::clear_array("test_huge_pages_array");
+    {
+        shared_memory::array<int> a("test_huge_pages_array",
+                                    10,
+                                    true,
+                                    shared_memory::ARRAY_MUTEX,
+                                    false,
+                                    false,
+                                    true);
+        ASSERT_TRUE(a.get_huge_pages());
+        a.set(3, 3);
+        int i;
+        a.get(3, i);
+        ASSERT_EQ(i, 3);
+
+        shared_memory::array<int> b("test_huge_pages_array", 10, false);
+        ASSERT_FALSE(b.get_huge_pages());
+    }
+
+    shared_memory::clear_array("test_huge_pages_static");
+    shared_memory::static_array<int, 10> s(
+        "test_huge_pages_static", true, true);
+    ASSERT_TRUE(s.get_huge_pages());
+}
+
+TEST_F(SharedMemoryTests, array_range)
+{
+    shared_memory::clear_array("test_array");
+
+    int size = 100;
+
+    shared_memory::array<int> a("test_array", size, true, true);
+    std::vector<int> values(size);
+    std::iota(values.begin(), values.end(), 0);
+    a.set_all(values);
+    int value;
+    a.get(50, value);
+    ASSERT_EQ(value, 50);
+
+    int range[10] = {0};
+    a.set_range(90, range, 10);
+    a.get_range(85, range, 10);
+    ASSERT_EQ(range[0], 85);
+    ASSERT_EQ(range[4], 89);
+    ASSERT_EQ(range[5], 0);
+
+    std::vector<int> snapshot;
+    a.get_all(snapshot);
+    ASSERT_EQ(snapshot.size(), size);
+    ASSERT_EQ(snapshot[10], 10);
+    ASSERT_EQ(snapshot[95], 0);
+
+    ASSERT_THROW(a.get_range(95, range, 10), std::runtime_error);
+}
+
+TEST_F(SharedMemoryTests, array_array_range)
+{
+    shared_memory::clear_array("test_array");
+
+    int size = 100;
+
+    shared_memory::array<int, 10> a("test_array", size, true, true);
+    std::vector<int> values(size * 10);
+    std::iota(values.begin(), values.end(), 0);
+    a.set_all(values);
+
+    int item[10];
+    a.get(3, *item);
+    ASSERT_EQ(item[0], 30);
+    ASSERT_EQ(item[9], 39);
+
+    std::vector<int> range(20);
+    a.get_range(5, range.data(), 2);
+    ASSERT_EQ(range[0], 50);
+    ASSERT_EQ(range[19], 69);
+
+    std::vector<int> snapshot;
+    a.get_all(snapshot);
+    ASSERT_EQ(snapshot, values);
+}
+
+TEST_F(SharedMemoryTests, array_serializable_range)
+{
+    shared_memory::clear_array("test_array");
+
+    int size = 100;
+
+    shared_memory::array<SerializedItem> a("test_array", size, true, true);
+
+    std::vector<SerializedItem> items;
+    for (int i = 0; i < size; i++)
+    {
+        items.push_back(SerializedItem(i));
+    }
+    a.set_range(0, items.data(), size);
+
+    SerializedItem item;
+    a.get(42, item);
+    ASSERT_EQ(item.get(), 42);
+
+    std::vector<SerializedItem> range(5);
+    a.get_range(10, range.data(), 5);
+    for (int i = 0; i < 5; i++)
+    {
+        ASSERT_EQ(range[i].get(), 10 + i);
+    }
+
+    std::vector<SerializedItem> snapshot;
+    a.get_all(snapshot);
+    ASSERT_EQ(snapshot.size(), size);
+    ASSERT_EQ(snapshot[99].get(), 99);
+}
+
+TEST_F(SharedMemoryTests, array_single_writer)
+{
+    shared_memory::clear_array("test_array");
+
+    int size = 10;
+    shared_memory::array<double, 20> written(
+        "test_array", size, true, shared_memory::ARRAY_SINGLE_WRITER);
+    shared_memory::array<double, 20> read(
+        "test_array", size, false, shared_memory::ARRAY_SINGLE_WRITER);
+
+    // readers should never see values written by different writes
+    std::thread writer([&written, size]() {
+        double values[20];
+        for (int iteration = 1; iteration < 10000; iteration++)
+        {
+            std::fill(values, values + 20, iteration);
+            written.set(iteration % size, values[0]);
+        }
+    });
+
+    double values[20];
+    for (int iteration = 0; iteration < 10000; iteration++)
+    {
+        read.get(iteration % size, values[0]);
+        for (int i = 1; i < 20; i++)
+        {
+            ASSERT_EQ(values[i], values[0]);
+        }
+    }
+    writer.join();
+
+    read.get(9999 % size, values[0]);
+    ASSERT_EQ(values[19], 9999.);
+}
+
+TEST_F(SharedMemoryTests, array_serializable_single_writer)
+{
+    shared_memory::clear_array("test_array");
+
+    int size = 10;
+    shared_memory::array<SerializedItem> written(
+        "test_array", size, true, shared_memory::ARRAY_SINGLE_WRITER);
+    shared_memory::array<SerializedItem> read(
+        "test_array", size, false, shared_memory::ARRAY_SINGLE_WRITER);
+
+    std::thread writer([&written, size]() {
+        std::vector<SerializedItem> items(size);
+        for (int iteration = 1; iteration < 1000; iteration++)
+        {
+            for (int i = 0; i < size; i++)
+            {
+                items[i].fill(iteration);
+            }
+            written.set_all(items);
+        }
+    });
+
+    SerializedItem item;
+    std::vector<SerializedItem> snapshot;
+    for (int iteration = 0; iteration < 1000; iteration++)
+    {
+        read.get(iteration % size, item);
+        for (int i = 0; i < 10; i++)
+        {
+            ASSERT_EQ(item.get(i), item.get());
+        }
+        read.get_all(snapshot);
+        for (int i = 1; i < size; i++)
+        {
+            ASSERT_EQ(snapshot[i].get(), snapshot[0].get());
+        }
+    }
+    writer.join();
+
+    read.get(3, item);
+    ASSERT_EQ(item.get(), 999);
+}
+
+TEST_F(SharedMemoryTests, ring_buffer)
+{
+    shared_memory::clear_array("test_ring_buffer");
+
+    shared_memory::ring_buffer<int> buffer("test_ring_buffer", 4);
+    ASSERT_EQ(buffer.capacity(), 4);
+
+    int value;
+    ASSERT_FALSE(buffer.try_pop(value));
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_TRUE(buffer.try_push(i));
+    }
+    ASSERT_FALSE(buffer.try_push(4));
+    ASSERT_EQ(buffer.size(), 4);
+    ASSERT_TRUE(buffer.try_pop(value));
+    ASSERT_EQ(value, 0);
+
+    // wrapping around the end of the array
+    std::vector<int> values{4, 5, 6};
+    ASSERT_EQ(buffer.try_push(values.data(), values.size()), 1);
+    std::vector<int> popped(10);
+    ASSERT_EQ(buffer.try_pop(popped.data(), popped.size()), 4);
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_EQ(popped[i], i + 1);
+    }
+    ASSERT_EQ(buffer.size(), 0);
+}
+
+TEST_F(SharedMemoryTests, ring_buffer_overwrite_oldest)
+{
+    shared_memory::clear_array("test_ring_buffer");
+
+    shared_memory::ring_buffer<shared_memory::Item<10>> buffer(
+        "test_ring_buffer",
+        4,
+        true,
+        shared_memory::SINGLE_CONSUMER,
+        shared_memory::OVERWRITE_OLDEST);
+
+    for (int i = 0; i < 6; i++)
+    {
+        ASSERT_TRUE(buffer.try_push(shared_memory::Item<10>(i)));
+    }
+    ASSERT_EQ(buffer.size(), 4);
+
+    std::vector<shared_memory::Item<10>> popped(10);
+    ASSERT_EQ(buffer.try_pop(popped.data(), popped.size()), 4);
+    for (int i = 0; i < 4; i++)
+    {
+        ASSERT_EQ(popped[i].get(), i + 2);
+    }
+
+    // pushing more items than the capacity at once
+    std::vector<shared_memory::Item<10>> items;
+    for (int i = 0; i < 10; i++)
+    {
+        items.push_back(shared_memory::Item<10>(i));
+    }
+    ASSERT_EQ(buffer.try_push(items.data(), items.size()), 10);
+    ASSERT_EQ(buffer.try_pop(popped.data(), popped.size()), 4);
+    ASSERT_EQ(popped[0].get(), 6);
+    ASSERT_EQ(popped[3].get(), 9);
+}
+
+TEST_F(SharedMemoryTests, ring_buffer_multiple_consumers)
+{
+    shared_memory::clear_array("test_ring_buffer");
+
+    int nb_items = 20000;
+    int nb_consumers = 3;
+    shared_memory::ring_buffer<int> producer("test_ring_buffer",
+                                             16,
+                                             true,
+                                             shared_memory::MULTIPLE_CONSUMERS);
+
+    // each item should be popped by exactly one consumer, and each
+    // consumer should pop items in order
+    std::atomic<int> nb_popped(0);
+    std::vector<long> sums(nb_consumers, 0);
+    std::vector<int> ordered(nb_consumers, true);
+    std::vector<std::thread> consumers;
+    for (int c = 0; c < nb_consumers; c++)
+    {
+        consumers.push_back(std::thread([&, c]() {
+            shared_memory::ring_buffer<int> consumer(
+                "test_ring_buffer",
+                16,
+                false,
+                shared_memory::MULTIPLE_CONSUMERS);
+            int values[4];
+            int previous = -1;
+            while (nb_popped < nb_items)
+            {
+                std::size_t nb = consumer.try_pop(values, 4);
+                if (nb == 0)
+                {
+                    std::this_thread::yield();
+                }
+                for (std::size_t i = 0; i < nb; i++)
+                {
+                    ordered[c] = ordered[c] && values[i] > previous;
+                    previous = values[i];
+                    sums[c] += values[i];
+                }
+                nb_popped += nb;
+            }
+        }));
+    }
+
+    for (int i = 0; i < nb_items; i++)
+    {
+        while (!producer.try_push(i))
+        {
+            std::this_thread::yield();
+        }
+    }
+    for (std::thread& consumer : consumers)
+    {
+        consumer.join();
+    }
+
+    long sum = 0;
+    for (int c = 0; c < nb_consumers; c++)
+    {
+        ASSERT_TRUE(ordered[c]);
+        sum += sums[c];
+    }
+    ASSERT_EQ(nb_popped, nb_items);
+    ASSERT_EQ(sum, static_cast<long>(nb_items) * (nb_items - 1) / 2);
+}
+
+// trivially copyable, but not serializable
+struct Contact
+{
+    int id;
+    double position[3];
+    double force[3];
+};
+
+TEST_F(SharedMemoryTests, array_trivially_copyable)
+{
+    shared_memory::clear_array("test_array");
+
+    int size = 10;
+    shared_memory::array<Contact> a("test_array", size, true, true);
+    shared_memory::array<Contact> b(a);
+
+    for (int i = 0; i < size; i++)
+    {
+        Contact contact{i, {1. * i, 2. * i, 3. * i}, {0, 0, -1. * i}};
+        a.set(i, contact);
+    }
+
+    Contact contact;
+    b.get(7, contact);
+    ASSERT_EQ(contact.id, 7);
+    ASSERT_EQ(contact.position[2], 21.);
+    ASSERT_EQ(contact.force[2], -7.);
+
+    std::vector<Contact> contacts;
+    b.get_all(contacts);
+    ASSERT_EQ(contacts.size(), size);
+    ASSERT_EQ(contacts[3].position[1], 6.);
+
+    ASSERT_THROW(a.set(size, contact), std::runtime_error);
+}
+
+// trivially copyable and serializable, without default constructor
+struct Stamp
+{
+    explicit Stamp(int value_) : value(value_)
+    {
+    }
+
+    template <class Archive>
+    void serialize(Archive& archive)
+    {
+        archive(value);
+    }
+
+    int value;
+};
+
+TEST_F(SharedMemoryTests, array_trivially_copyable_serialized)
+{
+    shared_memory::clear_array("test_array");
+
+    shared_memory::array<Stamp> a("test_array", 4, true, true);
+    a.set(2, Stamp(42));
+
+    shared_memory::Serializer<Stamp> serializer;
+    Stamp stamp(0);
+    serializer.deserialize(a.get_serialized(2), stamp);
+    ASSERT_EQ(stamp.value, 42);
+}
+
+TEST_F(SharedMemoryTests, array_trivially_copyable_item)
+{
+    // Item is serializable, but trivially copyable: stored directly
+    static_assert(std::is_trivially_copyable<shared_memory::Item<10>>::value,
+                  "Item should be stored directly");
+    shared_memory::clear_array("test_array");
+
+    int size = 10;
+    shared_memory::array<shared_memory::Item<10>> written(
+        "test_array", size, true, shared_memory::ARRAY_SINGLE_WRITER);
+    shared_memory::array<shared_memory::Item<10>> read(
+        "test_array", size, false, shared_memory::ARRAY_SINGLE_WRITER);
+
+    std::vector<shared_memory::Item<10>> items;
+    for (int i = 0; i < size; i++)
+    {
+        items.push_back(shared_memory::Item<10>(i));
+    }
+    written.set_range(0, items.data(), size);
+    written.set(5, shared_memory::Item<10>(50));
+
+    shared_memory::Item<10>* raw =
+        static_cast<shared_memory::Item<10>*>(read.get_raw());
+    ASSERT_EQ(raw[5].get(), 50);
+    ASSERT_EQ(raw[7].get(9), 7);
+
+    shared_memory::Item<10> item;
+    read.get(5, item);
+    ASSERT_EQ(item.get(9), 50);
+
+    std::vector<shared_memory::Item<10>> range(3);
+    read.get_range(2, range.data(), 3);
+    ASSERT_EQ(range[2].get(), 4);
+
+    std::vector<shared_memory::Item<10>> snapshot;
+    read.get_all(snapshot);
+    ASSERT_EQ(snapshot[9].get(), 9);
+
+    shared_memory::Serializer<shared_memory::Item<10>> serializer;
+    serializer.deserialize(read.get_serialized(3), item);
+    ASSERT_EQ(item.get(), 3);
+}
+
+TEST_F(SharedMemoryTests, array_serialized_item)
+{
+    shared_memory::clear_array("test_array");
+
+    int size = 10;
+    shared_memory::array<SerializedItem> a("test_array", size, true, true);
+
+    std::vector<SerializedItem> items;
+    for (int i = 0; i < size; i++)
+    {
+        items.push_back(SerializedItem(i));
+    }
+    a.set_all(items);
+    a.set(5, SerializedItem(50));
+
+    SerializedItem item;
+    a.get(5, item);
+    ASSERT_EQ(item.get(), 50);
+    ASSERT_EQ(item.get(9), 50);
+
+    std::vector<SerializedItem> range(3);
+    a.get_range(2, range.data(), 3);
+    ASSERT_EQ(range[2].get(), 4);
+
+    shared_memory::Serializer<SerializedItem> serializer;
+    serializer.deserialize(a.get_serialized(3), item);
+    ASSERT_EQ(item.get(), 3);
+}
+
+TEST_F(SharedMemoryTests, array_padded_slots)
+{
+    shared_memory::clear_array("test_array");
+
+    int size = 10;
+    shared_memory::array<double> a(
+        "test_array", size, true, shared_memory::ARRAY_MUTEX, true);
+    // the layout of the creator of the segment is used
+    shared_memory::array<double> b(
+        "test_array", size, false, shared_memory::ARRAY_MUTEX, false);
+
+    for (int i = 0; i < size; i++)
+    {
+        a.set(i, static_cast<double>(i));
+    }
+    double value;
+    b.get(7, value);
+    ASSERT_EQ(value, 7.);
+
+    char* raw = static_cast<char*>(a.get_raw());
+    ASSERT_EQ(reinterpret_cast<std::uintptr_t>(raw) % 64, 0);
+    ASSERT_EQ(*reinterpret_cast<double*>(raw + 3 * 64), 3.);
+
+    std::vector<double> values;
+    b.get_all(values);
+    ASSERT_EQ(values[9], 9.);
+
+    shared_memory::clear_array("test_array_serialized");
+    shared_memory::array<SerializedItem> c("test_array_serialized",
+                                           size,
+                                           true,
+                                           shared_memory::ARRAY_SINGLE_WRITER,
+                                           true);
+    std::vector<SerializedItem> items;
+    for (int i = 0; i < size; i++)
+    {
+        items.push_back(SerializedItem(i));
+    }
+    c.set_all(items);
+    SerializedItem item;
+    c.get(4, item);
+    ASSERT_EQ(item.get(), 4);
+    std::vector<SerializedItem> range(3);
+    c.get_range(7, range.data(), 3);
+    ASSERT_EQ(range[2].get(), 9);
+}
+
+TEST_F(SharedMemoryTests, array_wait_for_update)
+{
+    shared_memory::clear_array("test_array");
+
+    int size = 10;
+    shared_memory::array<double> a(
+        "test_array", size, true, shared_memory::ARRAY_MUTEX, false, true);
+
+    std::uint64_t generation = a.get_generation(3);
+    std::uint64_t array_generation = a.get_generation();
+    ASSERT_FALSE(a.wait_for_update(3, generation, 1000000));
+
+    a.set(4, 4.);
+    ASSERT_EQ(a.get_generation(3), generation);
+    ASSERT_EQ(a.get_generation(), array_generation + 1);
+    ASSERT_FALSE(a.wait_for_update(3, generation, 1000000));
+    ASSERT_TRUE(a.wait_for_any_update(array_generation, 1000000));
+
+    std::thread writer([size]() {
+        shared_memory::array<double> b("test_array", size, false, true);
+        usleep(20000);
+        b.set(3, 3.);
+    });
+    ASSERT_TRUE(a.wait_for_update(3, generation));
+    double value;
+    a.get(3, value);
+    ASSERT_EQ(value, 3.);
+    ASSERT_EQ(a.get_generation(3), generation + 1);
+    writer.join();
+
+    std::vector<double> values(size, 1.);
+    a.set_all(values);
+    ASSERT_EQ(a.get_generation(3), generation + 2);
+}
+
+TEST_F(SharedMemoryTests, array_get_changed_since)
+{
+    shared_memory::clear_array("test_array");
+
+    int size = 1000;
+    shared_memory::array<double> a(
+        "test_array", size, true, shared_memory::ARRAY_MUTEX, false, true);
+
+    std::vector<double> mirror(size, 0.);
+    std::vector<uint> changed;
+    auto update_mirror = [&mirror, &changed](uint index, const double& value) {
+        mirror[index] = value;
+        changed.push_back(index);
+    };
+
+    std::uint64_t epoch = a.get_changed_since(0, update_mirror);
+    ASSERT_TRUE(changed.empty());
+
+    a.set(3, 3.);
+    a.set(700, 700.);
+    epoch = a.get_changed_since(epoch, update_mirror);
+    ASSERT_EQ(changed.size(), 2);
+    ASSERT_EQ(mirror[3], 3.);
+    ASSERT_EQ(mirror[700], 700.);
+
+    changed.clear();
+    epoch = a.get_changed_since(epoch, update_mirror);
+    ASSERT_TRUE(changed.empty());
+
+    std::vector<double> values(10, 1.);
+    a.set_range(60, values.data(), values.size());
+    a.set(3, 4.);
+    epoch = a.get_changed_since(epoch, update_mirror);
+    ASSERT_EQ(changed.size(), 11);
+    ASSERT_EQ(mirror[3], 4.);
+    ASSERT_EQ(mirror[69], 1.);
+
+    // arrays of arrays
+    shared_memory::clear_array("test_array_array");
+    shared_memory::array<int, 4> b("test_array_array",
+                                   100,
+                                   true,
+                                   shared_memory::ARRAY_MUTEX,
+                                   false,
+                                   true);
+    int item[4] = {1, 2, 3, 4};
+    b.set(42, item[0]);
+    int last = 0;
+    b.get_changed_since(0, [&last](uint, const int& value) {
+        last = (&value)[3];
+    });
+    ASSERT_EQ(last, 4);
+}
+
+TEST_F(SharedMemoryTests, array_track_changes)
+{
+    shared_memory::clear_array("test_array");
+    {
+        // changes are not tracked by default
+        shared_memory::array<double> a("test_array", 10, true, true);
+        a.set(3, 3.);
+        ASSERT_THROW(a.get_generation(3), std::logic_error);
+        ASSERT_THROW(a.get_generation(), std::logic_error);
+        ASSERT_THROW(a.wait_for_any_update(0, 1000), std::logic_error);
+        ASSERT_THROW(a.get_changed_since(0, [](uint, const double&) {}),
+                     std::logic_error);
+    }
+
+    // the instance creating the segment decides, and stamps of padded
+    // arrays are in their own cache lines
+    shared_memory::array<double> a(
+        "test_array", 100, true, shared_memory::ARRAY_MUTEX, true, true);
+    shared_memory::array<double> b("test_array", 100, false, true);
+    b.set(70, 70.);
+    b.set(71, 71.);
+    ASSERT_EQ(a.get_generation(70), 1);
+    ASSERT_EQ(a.get_generation(71), 1);
+    ASSERT_EQ(a.get_generation(72), 0);
+    ASSERT_EQ(a.get_generation(), 2);
+    std::vector<uint> changed;
+    a.get_changed_since(1, [&changed](uint index, const double&) {
+        changed.push_back(index);
+    });
+    ASSERT_EQ(changed, std::vector<uint>{71});
+}
+
+TEST_F(SharedMemoryTests, array_copy_shares_mapping)
+{
+    shared_memory::clear_array("test_array");
+
+    shared_memory::array<double> b("test_array", 10, false, true);
+    {
+        shared_memory::array<double> a("test_array", 10, true, true);
+        a.set(2, 5.);
+        shared_memory::array<double> copy(a);
+        // copies point to the same mapping, not only to the same segment
+        ASSERT_EQ(copy.get_raw(), a.get_raw());
+        std::thread worker([copy]() mutable { copy.set(3, 6.); });
+        worker.join();
+        double value;
+        a.get(3, value);
+        ASSERT_EQ(value, 6.);
+    }
+    // the segment has been wiped by the last copy of a
+    shared_memory::array<double> c("test_array", 10, true, true);
+    double value;
+    c.get(2, value);
+    ASSERT_EQ(value, 0.);
+
+    // moving assigns the mapping, and the duty of wiping the segment
+    shared_memory::array<double> d("test_array_2", 10, true, true);
+    d.set(1, 7.);
+    c = std::move(d);
+    c.get(1, value);
+    ASSERT_EQ(value, 7.);
+}
+
+TEST_F(SharedMemoryTests, static_array)
+{
+    shared_memory::clear_array("test_static_array");
+
+    static_assert(shared_memory::static_array<double, 10>::size() == 10,
+                  "unexpected size");
+    static_assert(shared_memory::static_array<double, 10>::offset(3) ==
+                      3 * sizeof(double),
+                  "unexpected offset");
+
+    shared_memory::static_array<double, 10> a("test_static_array", true);
+    a.set(2, 5.);
+    a.set_unchecked(3, 6.);
+    shared_memory::static_array<double, 10> b("test_static_array", false);
+    double value;
+    b.get(2, value);
+    ASSERT_EQ(value, 5.);
+    b.get_unchecked(3, value);
+    ASSERT_EQ(value, 6.);
+    ASSERT_THROW(b.set(10, value), std::runtime_error);
+    ASSERT_THROW(b.get(10, value), std::runtime_error);
+
+    // attaching with another layout
+    bool thrown = false;
+    try
+    {
+        shared_memory::static_array<double, 20> c("test_static_array", true);
+    }
+    catch (const std::runtime_error&)
+    {
+        thrown = true;
+    }
+    ASSERT_TRUE(thrown);
+    // and the mutex of the owner has been neither removed nor unlocked
+    {
+        boost::interprocess::named_mutex mutex(boost::interprocess::open_only,
+                                               "test_static_array_mutex");
+        mutex.lock();
+        ASSERT_FALSE(mutex.try_lock());
+        mutex.unlock();
+    }
+    a.set(2, 5.);
+    // nor the segment wiped
+    a.get(2, value);
+    ASSERT_EQ(value, 5.);
+    shared_memory::static_array<double, 10> d("test_static_array", false);
+    d.get(2, value);
+    ASSERT_EQ(value, 5.);
+
+    // trivially copyable structs, single writer
+    shared_memory::clear_array("test_static_array_2");
+    shared_memory::static_array<Contact, 4, shared_memory::ARRAY_SINGLE_WRITER>
+        e("test_static_array_2", true);
+    Contact contact{};
+    contact.position[1] = 2.;
+    e.set(3, contact);
+    Contact read{};
+    e.get(3, read);
+    ASSERT_EQ(read.position[1], 2.);
+
+    // attaching with another synchronization
+    ASSERT_THROW(
+        (shared_memory::static_array<Contact, 4, shared_memory::ARRAY_MUTEX>(
+            "test_static_array_2", false)),
+        std::runtime_error);
+    // (and not running out of memory constructing the sequences in a
+    // segment sized for an array without sequences)
+    typedef shared_memory::
+        static_array<double, 10, shared_memory::ARRAY_SINGLE_WRITER>
+            SingleWriterArray;
+    ASSERT_THROW(SingleWriterArray("test_static_array", false),
+                 std::runtime_error);
+    e.get(3, read);
+    ASSERT_EQ(read.position[1], 2.);
+}
+
+TEST_F(SharedMemoryTests, array_segment_size)
+{
+    // segments are created at the size of the objects of the array,
+    // plus a safety margin
+    std::size_t max_free_memory =
+        shared_memory::internal::SegmentSizer::SAFETY_MARGIN + 64;
+    shared_memory::clear_array("test_array");
+    {
+        shared_memory::array<double> a("test_array", 1000, true, true);
+        boost::interprocess::managed_shared_memory segment(
+            boost::interprocess::open_only, "test_array");
+        shared_memory::SegmentInfo si(segment);
+        ASSERT_LT(si.get_free_memory(), max_free_memory);
+        // the memory of the segment manager follows the header
+        boost::interprocess::shared_memory_object shm(
+            boost::interprocess::open_only,
+            "test_array",
+            boost::interprocess::read_only);
+        boost::interprocess::offset_t shm_size;
+        ASSERT_TRUE(shm.get_size(shm_size));
+        ASSERT_EQ(static_cast<std::size_t>(shm_size) -
+                      segment.get_segment_manager()->get_size(),
+                  shared_memory::internal::SegmentSizer::get_header_size());
+        ASSERT_LT(si.get_size(), 1000 * 3 * sizeof(double) + 2048);
+    }
+    {
+        shared_memory::array<SerializedItem> a(
+            "test_array", 500, true, shared_memory::ARRAY_SINGLE_WRITER, true);
+        boost::interprocess::managed_shared_memory segment(
+            boost::interprocess::open_only, "test_array");
+        shared_memory::SegmentInfo si(segment);
+        ASSERT_LT(si.get_free_memory(), max_free_memory);
+        SerializedItem item(3);
+        a.set(499, item);
+    }
+    {
+        shared_memory::ring_buffer<int> buffer(
+            "test_array", 100, true, shared_memory::MULTIPLE_CONSUMERS);
+        ASSERT_TRUE(buffer.try_push(1));
+    }
+    {
+        shared_memory::static_array<double, 100> a("test_array", true);
+        boost::interprocess::managed_shared_memory segment(
+            boost::interprocess::open_only, "test_array");
+        shared_memory::SegmentInfo si(segment);
+        ASSERT_LT(si.get_free_memory(), max_free_memory);
+    }
+}
+
+TEST_F(SharedMemoryTests, array_sync_mismatch)
+{
+    shared_memory::clear_array("test_array");
+    shared_memory::array<double> a(
+        "test_array", 10, true, shared_memory::ARRAY_MUTEX);
+    a.set(3, 3.);
+
+    // the segment has no room for sequences
+    ASSERT_THROW(shared_memory::array<double>(
+                     "test_array", 10, true, shared_memory::ARRAY_SINGLE_WRITER),
+                 std::runtime_error);
+    // not wiped
+    shared_memory::array<double> b(
+        "test_array", 10, false, shared_memory::ARRAY_UNSYNCHRONIZED);
+    double value;
+    b.get(3, value);
+    ASSERT_EQ(value, 3.);
+
+    shared_memory::clear_array("test_array_2");
+    shared_memory::array<double> c(
+        "test_array_2", 10, true, shared_memory::ARRAY_SINGLE_WRITER);
+    ASSERT_THROW(shared_memory::array<double>("test_array_2", 10, false, true),
+                 std::runtime_error);
+}